@@ -3,78 +3,341 @@
 //
 
 #include "Acker.h"
+#include "FlowerCount.h"
+#include "Profiler.h"
 
-Acker::Acker(const std::vector<std::string>& lines, std::string  path) : m_lines(lines), m_path(std::move(path)){
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <optional>
+
+Acker::Acker(const std::vector<std::string>& lines, std::string  path) : m_path(std::move(path)){
+    init(std::vector<std::string_view>(lines.begin(), lines.end()));
+}
+
+Acker::Acker(std::string_view text, std::string path) : m_path(std::move(path)) {
+    std::vector<std::string_view> lines;
+    split_lines(text, lines);
+    init(lines);
+}
+
+Acker::Acker(int rows, int columns, std::vector<uint64_t> bits, std::string path)
+        : m_bits(std::move(bits)), m_columns(columns), m_rows(rows), m_words(words_for(columns)), m_path(std::move(path)) {
+    m_bits.resize(size_t(m_rows) * m_words, 0);
+    m_row_flowers.assign(m_rows, 0);
+    for (int i=0; i < m_rows; ++i) {
+        uint64_t* bits = mutable_row_bits(i);
+        if (m_words > 0)
+            bits[m_words - 1] &= tail_mask(m_columns);
+        for (int w=0; w < m_words; ++w) {
+            m_row_flowers[i] += popcount64(bits[w]);
+        }
+    }
+    m_flowers = get_flowers();
+}
+
+Acker Acker::from_file(const std::string& path, bool with_index) {
+    std::optional<MappedFile> file;
+    {
+        ProfileScope scope("read");
+        file.emplace(path, MappedFile::Advice::sequential);
+    }
+    ProfileScope scope("parse");
+    Acker acker(file->view(), path);
+    if (with_index)
+        acker.build_index();
+    return acker;
+}
+
+void Acker::build_index() {
+    m_index = FlowerIndex(m_bits.data(), m_rows, m_columns, m_words, uint64_t(m_flowers));
+}
+
+uint64_t Acker::count_flowers(int row0, int col0, int row1, int col1) const {
+    if (has_index())
+        return m_index.count(row0, col0, row1, col1);
+    row0 = std::max(row0, 0);
+    col0 = std::max(col0, 0);
+    row1 = std::min(row1, m_rows);
+    col1 = std::min(col1, m_columns);
+    uint64_t flowers = 0;
+    for (int i=row0; i < row1 && col0 < col1; ++i) {
+        const uint64_t* bits = row_bits(i);
+        for (int w=col0 / WORD_BITS; w <= (col1 - 1) / WORD_BITS; ++w) {
+            uint64_t word = bits[w];
+            if (w == col0 / WORD_BITS)
+                word &= mask_from(col0 % WORD_BITS);
+            if (w == (col1 - 1) / WORD_BITS)
+                word &= tail_mask(col1);
+            flowers += popcount64(word);
+        }
+    }
+    return flowers;
+}
+
+void Acker::init(const std::vector<std::string_view>& lines) {
     m_rows = int(lines.size());
     if (m_rows > 0) {
         m_columns = int(lines[0].size());
     } else {
         m_columns = 0;
     }
+    m_words = words_for(m_columns);
+    m_bits.assign(size_t(m_rows) * m_words, 0);
+    m_row_flowers.assign(m_rows, 0);
+    for (int i=0; i < m_rows; ++i) {
+        const std::string_view& line = lines[i];
+        const size_t length = std::min(line.size(), size_t(m_columns));
+        m_row_flowers[i] = int(pack_flowers(line.data(), length, mutable_row_bits(i)));
+    }
     m_flowers = get_flowers();
 }
 
-void Acker::print_out(bool show_file) {
+void Acker::print_out(OutputSink& out, bool show_file) const {
     std::string rows = format(m_rows, 3);
     std::string columns = format(m_columns, 3);
     std::string flowers = format(m_flowers, 6);
-    std::cout << m_path << ": Zeilen=" << rows << ", Spalten=" << columns << ", Blumen=" << flowers << std::endl;
+    out << m_path << ": Zeilen=" << rows << ", Spalten=" << columns << ", Blumen=" << flowers << '\n';
 
     if (show_file) {
-        std::cout << "  ";
+        out << "  ";
         for (int i=0; i < m_columns; ++i) {
-            std::cout << ' ' << i;
+            out << ' ' << i;
         }
-        std::cout << std::endl;
+        out << '\n';
 
         for (int i=0; i < m_rows; ++i) {
-            std::cout << i << ":";
+            out << i << ":";
             for (int j=0; j < m_columns; ++j) {
-                std::cout << ' ' << m_lines[i][j];
+                out << ' ' << (has_flower(i, j) ? '*' : ' ');
             }
-            std::cout << std::endl;
+            out << '\n';
         }
     }
 }
 
-int Acker::get_flowers() {
-    int flowers = 0;
-    for (const std::string& line : m_lines) {
-        for (const char& ch : line) {
-            flowers += flowers_per_row(line);
-        }
+long Acker::get_flowers() {
+    long flowers = 0;
+    for (const int& row_flowers : m_row_flowers) {
+        flowers += row_flowers;
     }
     return flowers;
 }
 
+bool Acker::has_flower(int row, int col) const {
+    return (row_bits(row)[col / WORD_BITS] >> (col % WORD_BITS)) & 1;
+}
+
+bool Acker::set_flower(int row, int col, bool flower) {
+    if (row < 0 || row >= m_rows || col < 0 || col >= m_columns) {
+        throw pbma_exception("set_flower: außerhalb des Feldes", std::to_string(row) + "," + std::to_string(col));
+    }
+    uint64_t& word = mutable_row_bits(row)[col / WORD_BITS];
+    const uint64_t bit = uint64_t(1) << (col % WORD_BITS);
+    if (bool(word & bit) == flower)
+        return false;
+    word ^= bit;
+    const int delta = flower ? 1 : -1;
+    m_row_flowers[row] += delta;
+    m_flowers += delta;
+    if (has_index())
+        m_index = FlowerIndex();
+    return true;
+}
+
+int Acker::next_flower(int row, int col) const {
+    if (col < 0)
+        col = 0;
+    if (col >= m_columns)
+        return -1;
+    const uint64_t* bits = row_bits(row);
+    int w = col / WORD_BITS;
+    uint64_t word = bits[w] & mask_from(col % WORD_BITS);
+    while (!word) {
+        if (++w == m_words)
+            return -1;
+        word = bits[w];
+    }
+    return w * WORD_BITS + ctz64(word);
+}
+
+int Acker::prev_flower(int row, int col) const {
+    if (col >= m_columns)
+        col = m_columns - 1;
+    if (col < 0)
+        return -1;
+    const uint64_t* bits = row_bits(row);
+    int w = col / WORD_BITS;
+    const int bit = col % WORD_BITS;
+    uint64_t word = bit == WORD_BITS - 1 ? bits[w] : bits[w] & ~mask_from(bit + 1);
+    while (!word) {
+        if (--w < 0)
+            return -1;
+        word = bits[w];
+    }
+    return w * WORD_BITS + msb64(word);
+}
+
+int Acker::last_flower(int row) const {
+    const uint64_t* bits = row_bits(row);
+    for (int w=m_words-1; w >= 0; --w) {
+        if (bits[w])
+            return w * WORD_BITS + msb64(bits[w]);
+    }
+    return -1;
+}
+
 int Acker::flowers_per_row(const std::string& row) {
-    int flowers = 0;
-    for (const char& ch : row) {
-        if (ch == '*')
-            flowers += 1;
+    return int(::count_flowers(row.data(), row.size()));
+}
+
+std::vector<Tour> Acker::simple_solution(long& steps, int& tour_numbers) const {
+    std::vector<Tour> tours;
+
+    for (int i=m_rows-1; i >= 0; --i) {
+        if (!row_empty(i)) {
+            Tour tour;
+            tour.append(Tour::UP, (m_rows-1)-i);
+            tour.append(Tour::RIGHT, m_columns);
+            steps += tour.steps();
+            tours.push_back(std::move(tour));
+            tour_numbers += 1;
+        }
     }
-    return flowers;
+    return tours;
+}
+
+// Eine Tour nimmt in jeder Zeile alle Blumen ab ihrer aktuellen Spalte, übrig
+// bleibt also immer ein Präfix der Zeile. Je Zeile genügt daher die letzte
+// verbliebene Blume; ein Durchlauf kostet O(1) je aktiver Zeile, nur beim
+// Ernten wird mit prev_flower die neue letzte Blume gesucht.
+std::vector<Tour> Acker::last_flower_solution(long& steps, int& tour_numbers) const {
+    std::vector<Tour> tours;
+    std::vector<int> last(size_t(m_rows), -1);
+    std::vector<int> active;
+    for (int i=m_rows-1; i >= 0; --i) {
+        if (!row_empty(i)) {
+            active.push_back(i);
+            last[i] = last_flower(i);
+        }
+    }
+
+    std::vector<int> still_active;
+    while (!active.empty()) {
+        Tour tour;
+        int row = m_rows-1;
+        int col = -1;
+        still_active.clear();
+        for (const int& i : active) {
+            const int from = std::max(col, 0);
+            if (last[i] >= from) {
+                tour.append(Tour::UP, row - i);
+                tour.append(Tour::RIGHT, last[i] - col);
+                row = i;
+                col = last[i];
+                last[i] = from > 0 ? prev_flower(i, from - 1) : -1;
+            }
+            if (last[i] >= 0)
+                still_active.push_back(i);
+        }
+        steps += tour.steps();
+        tours.push_back(std::move(tour));
+        tour_numbers += 1;
+        active.swap(still_active);
+    }
+    return tours;
 }
 
-std::vector<std::string> Acker::simple_solution(int& steps, int& tour_numbers) {
-    std::vector<std::string> tours;
-    std::string tour;
+// Die Blumen werden von unten nach oben und je Zeile von links nach rechts
+// durchlaufen. Jede Blume hängt an die Tour mit der größten Endspalte <= ihrer
+// Spalte, sonst beginnt eine neue Tour. Die Endspalten bleiben dabei absteigend
+// sortiert und paarweise verschieden, die Anzahl der Touren ist die Länge der
+// längsten Antikette (Dilworth) und damit minimal. Laufzeit O(F log F).
+std::vector<Tour> Acker::min_tour_solution(long& steps, int& tour_numbers) const {
+    std::vector<Tour> tours;
+    std::vector<int> tops;
+    std::vector<int> tour_of_top;
+    std::vector<int> end_row;
+    std::vector<int> end_col;
 
     for (int i=m_rows-1; i >= 0; --i) {
-        bool flowers_in_row = bool(flowers_per_row(m_lines[i]));
-        if (flowers_in_row) {
-            for (int k=(m_rows-1)-i; k > 0; --k) {
-                tour.append("o");
-                steps += 1;
+        if (row_empty(i))
+            continue;
+        const uint64_t* bits = row_bits(i);
+        for (int w=0; w < m_words; ++w) {
+            for (uint64_t word = bits[w]; word; word &= word - 1) {
+                const int col = w * WORD_BITS + ctz64(word);
+                auto it = std::lower_bound(tops.begin(), tops.end(), col, std::greater<int>());
+                int t;
+                if (it == tops.end()) {
+                    t = int(tours.size());
+                    tops.push_back(col);
+                    tour_of_top.push_back(t);
+                    tours.emplace_back();
+                    end_row.push_back(m_rows-1);
+                    end_col.push_back(-1);
+                } else {
+                    *it = col;
+                    t = tour_of_top[it - tops.begin()];
+                }
+                tours[t].append(Tour::UP, end_row[t] - i);
+                tours[t].append(Tour::RIGHT, col - end_col[t]);
+                end_row[t] = i;
+                end_col[t] = col;
             }
-            for (int j=0; j < m_columns; ++j) {
-                tour.append("r");
-                steps += 1;
+        }
+    }
+    for (const Tour& tour : tours) {
+        steps += tour.steps();
+    }
+    tour_numbers += int(tours.size());
+    return tours;
+}
+
+std::vector<Tour> Acker::capacity_solution(int capacity, long& steps, int& tour_numbers) const {
+    if (capacity <= 0)
+        return min_tour_solution(steps, tour_numbers);
+    std::vector<Tour> tours;
+    std::vector<int> load;
+    std::vector<int> end_row;
+    std::vector<int> end_col;
+    // nicht volle Touren nach Spalte ihrer letzten Blume, Spalten sind eindeutig
+    std::map<int, int> open;
+
+    for (int i=m_rows-1; i >= 0; --i) {
+        if (row_empty(i))
+            continue;
+        const uint64_t* bits = row_bits(i);
+        for (int w=0; w < m_words; ++w) {
+            for (uint64_t word = bits[w]; word; word &= word - 1) {
+                const int col = w * WORD_BITS + ctz64(word);
+                // wie beim Patience Sorting die Tour mit der größten Spalte <= col
+                auto it = open.upper_bound(col);
+                int t;
+                if (it == open.begin()) {
+                    t = int(tours.size());
+                    tours.emplace_back();
+                    load.push_back(0);
+                    end_row.push_back(m_rows-1);
+                    end_col.push_back(-1);
+                } else {
+                    --it;
+                    t = it->second;
+                    open.erase(it);
+                }
+                tours[t].append(Tour::UP, end_row[t] - i);
+                tours[t].append(Tour::RIGHT, col - end_col[t]);
+                end_row[t] = i;
+                end_col[t] = col;
+                // volle Touren fahren heim und nehmen nichts mehr auf
+                if (++load[t] < capacity)
+                    open[col] = t;
             }
-            tours.push_back(tour);
-            tour.clear();
-            tour_numbers += 1;
         }
     }
+    for (const Tour& tour : tours) {
+        steps += tour.steps();
+    }
+    tour_numbers += int(tours.size());
     return tours;
 }
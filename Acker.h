@@ -5,26 +5,72 @@
 #ifndef BUGA_PROJ_ACKER_H
 #define BUGA_PROJ_ACKER_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include "pbma.h"
+#include "Bits.h"
+#include "Tour.h"
+#include "FlowerIndex.h"
+#include "OutputSink.h"
 
 
 class Acker {
-    std::vector<std::string> m_lines;
+    // bitgepackt, je Zeile m_words Wörter, ein Bit je Blume
+    std::vector<uint64_t> m_bits;
+    std::vector<int> m_row_flowers;
     int m_columns;
     int m_rows;
-    int m_flowers;
+    int m_words;
+    long m_flowers;
     std::string m_path;
+    FlowerIndex m_index;
 
-    int get_flowers();
+    long get_flowers();
+    void init(const std::vector<std::string_view>& lines);
+    uint64_t* mutable_row_bits(int row) { return m_bits.data() + size_t(row) * m_words; }
 public:
     Acker(const std::vector<std::string>& lines, std::string  path);
+    // Zeilen direkt aus einem Textpuffer, Kommentar- und Leerzeilen wie read_lines
+    Acker(std::string_view text, std::string path);
+    // bereits gepackte Zeilen, words_for(columns) Wörter je Zeile
+    Acker(int rows, int columns, std::vector<uint64_t> bits, std::string path);
+    // blendet die Datei per mmap ein und packt ohne Zwischenkopie
+    static Acker from_file(const std::string& path, bool with_index = false);
     int get_rows() const { return m_rows; }
     int get_columns() const { return m_columns; }
+    int get_words() const { return m_words; }
+    long get_flower_count() const { return m_flowers; }
+    const std::string& get_path() const { return m_path; }
+    const uint64_t* row_bits(int row) const { return m_bits.data() + size_t(row) * m_words; }
+    bool has_flower(int row, int col) const;
+    // setzt oder entfernt eine Blume, O(1); true, wenn sich das Feld ändert.
+    // Ein vorhandener Index wird verworfen.
+    bool set_flower(int row, int col, bool flower);
+    int flowers_in_row(int row) const { return m_row_flowers[row]; }
+    bool row_empty(int row) const { return m_row_flowers[row] == 0; }
+    // erste Blume in Zeile row ab Spalte col, -1 wenn keine
+    int next_flower(int row, int col) const;
+    // letzte Blume in Zeile row bis einschließlich Spalte col, -1 wenn keine
+    int prev_flower(int row, int col) const;
+    // letzte Blume in Zeile row, -1 wenn keine
+    int last_flower(int row) const;
+    // optionaler Präfixsummen-Index für O(1)-Rechteckabfragen
+    void build_index();
+    bool has_index() const { return !m_index.empty(); }
+    const FlowerIndex& get_index() const { return m_index; }
+    // Blumen in Zeilen [row0, row1) und Spalten [col0, col1), mit Index O(1)
+    uint64_t count_flowers(int row0, int col0, int row1, int col1) const;
     static int flowers_per_row(const std::string& row);
-    void print_out(bool show_file);
-    std::vector<std::string> simple_solution(int& steps, int& tour_numbers);
+    void print_out(OutputSink& out, bool show_file) const;
+    std::vector<Tour> simple_solution(long& steps, int& tour_numbers) const;
+    // jede Tour endet an ihrer letzten Blume und sammelt in mehreren Zeilen
+    std::vector<Tour> last_flower_solution(long& steps, int& tour_numbers) const;
+    // minimale Anzahl Touren, Zerlegung in monotone Ketten (Patience Sorting)
+    std::vector<Tour> min_tour_solution(long& steps, int& tour_numbers) const;
+    // wie min_tour_solution, aber höchstens capacity Blumen je Tour (capacity <= 0: unbegrenzt)
+    std::vector<Tour> capacity_solution(int capacity, long& steps, int& tour_numbers) const;
 };
 
 
@@ -0,0 +1,114 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "BinaryField.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+static const char MAGIC[8] = {'B', 'U', 'G', 'A', 'F', 'L', 'D', '1'};
+static const uint32_t VERSION = 1;
+
+static_assert(sizeof(BinaryFieldHeader) == 64, "Kopf muss 64 Bytes haben");
+
+static BinaryFieldHeader read_header(std::ifstream& in, const std::string& path) {
+    BinaryFieldHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw pbma_exception("load_binary_field: kein Binärfeld", path);
+    }
+    if (header.version != VERSION) {
+        throw pbma_exception("load_binary_field: unbekannte Version", int(header.version));
+    }
+    // Acker rechnet die Wortzahl aus den Spalten nach, beides muss passen
+    const uint64_t words = (header.columns + WORD_BITS - 1) / WORD_BITS;
+    if (header.rows > uint64_t(INT_MAX) || header.columns > uint64_t(INT_MAX) || header.words != words) {
+        throw pbma_exception("load_binary_field: Kopf beschädigt", path);
+    }
+    return header;
+}
+
+bool is_binary_field(const std::string& path) {
+    std::ifstream in(path, std::ifstream::binary);
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+BinaryFieldHeader read_binary_header(const std::string& path) {
+    std::ifstream in(path, std::ifstream::binary);
+    if (!in) {
+        throw pbma_exception("read_binary_header: nicht lesbar", path);
+    }
+    return read_header(in, path);
+}
+
+void save_binary_field(const Acker& acker, const std::string& path) {
+    std::ofstream out(path, std::ofstream::binary);
+    if (!out) {
+        throw pbma_exception("save_binary_field: nicht schreibbar", path);
+    }
+    const uint64_t rows = uint64_t(acker.get_rows());
+    const uint64_t row_bytes = uint64_t(acker.get_words()) * sizeof(uint64_t);
+
+    BinaryFieldHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.words = uint32_t(acker.get_words());
+    header.rows = rows;
+    header.columns = uint64_t(acker.get_columns());
+    header.flowers = uint64_t(acker.get_flower_count());
+    header.index_offset = sizeof(header);
+    header.data_offset = header.index_offset + (rows + 1) * sizeof(uint64_t);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<uint64_t> index(rows + 1);
+    for (uint64_t i=0; i <= rows; ++i) {
+        index[i] = i * row_bytes;
+    }
+    out.write(reinterpret_cast<const char*>(index.data()), std::streamsize(index.size() * sizeof(uint64_t)));
+    if (rows > 0) {
+        out.write(reinterpret_cast<const char*>(acker.row_bits(0)), std::streamsize(rows * row_bytes));
+    }
+    if (!out) {
+        throw pbma_exception("save_binary_field: Schreibfehler", path);
+    }
+}
+
+Acker load_binary_field(const std::string& path, int first_row, int row_count) {
+    ProfileScope scope("read");
+    std::ifstream in(path, std::ifstream::binary);
+    if (!in) {
+        throw pbma_exception("load_binary_field: nicht lesbar", path);
+    }
+    const BinaryFieldHeader header = read_header(in, path);
+    const int rows = int(header.rows);
+    first_row = std::min(std::max(first_row, 0), rows);
+    if (row_count < 0 || row_count > rows - first_row)
+        row_count = rows - first_row;
+
+    // nur die beiden Index-Einträge am Rand des Bereichs
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    in.seekg(std::streamoff(header.index_offset + uint64_t(first_row) * sizeof(uint64_t)));
+    in.read(reinterpret_cast<char*>(&begin), sizeof(begin));
+    in.seekg(std::streamoff(header.index_offset + (uint64_t(first_row) + uint64_t(row_count)) * sizeof(uint64_t)));
+    in.read(reinterpret_cast<char*>(&end), sizeof(end));
+    const uint64_t row_bytes = uint64_t(header.words) * sizeof(uint64_t);
+    if (!in || end < begin || end - begin != uint64_t(row_count) * row_bytes) {
+        throw pbma_exception("load_binary_field: Index beschädigt", path);
+    }
+
+    std::vector<uint64_t> bits(size_t(row_count) * header.words);
+    in.seekg(std::streamoff(header.data_offset + begin));
+    in.read(reinterpret_cast<char*>(bits.data()), std::streamsize(end - begin));
+    if (!in) {
+        throw pbma_exception("load_binary_field: Einlesefehler", path);
+    }
+    return Acker(row_count, int(header.columns), std::move(bits), path);
+}
@@ -0,0 +1,39 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_BINARYFIELD_H
+#define BUGA_PROJ_BINARYFIELD_H
+
+#include <cstdint>
+#include <string>
+#include "Acker.h"
+
+// Binärformat für Felder, little endian:
+//   Kopf, 64 Bytes: Magic "BUGAFLD1", Version, Wörter je Zeile, Zeilen,
+//                   Spalten, Blumen, Offset des Index, Offset der Daten
+//   Index: rows + 1 Offsets (uint64) der Zeilen relativ zum Datenbeginn
+//   Daten: je Zeile die bitgepackten Wörter wie in Acker
+// Über den Index kann ein Zeilenbereich geladen werden, ohne den Rest der
+// Datei zu lesen; die Daten landen mit einem read direkt in den Zeilen.
+struct BinaryFieldHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t words;
+    uint64_t rows;
+    uint64_t columns;
+    uint64_t flowers;
+    uint64_t index_offset;
+    uint64_t data_offset;
+    uint64_t reserved;
+};
+
+bool is_binary_field(const std::string& path);
+BinaryFieldHeader read_binary_header(const std::string& path);
+
+void save_binary_field(const Acker& acker, const std::string& path);
+
+// Zeilen [first_row, first_row + row_count), row_count < 0: bis zum Ende
+Acker load_binary_field(const std::string& path, int first_row = 0, int row_count = -1);
+
+#endif //BUGA_PROJ_BINARYFIELD_H
@@ -0,0 +1,70 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_BITS_H
+#define BUGA_PROJ_BITS_H
+
+#include <cstdint>
+
+// Wortweise Bitoperationen für die bitgepackten Zeilen des Ackers,
+// Spalte j liegt in Wort j / 64, Bit j % 64 (niederwertigstes Bit zuerst).
+
+constexpr int WORD_BITS = 64;
+
+inline int words_for(int columns) {
+    return (columns + WORD_BITS - 1) / WORD_BITS;
+}
+
+inline int popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count += 1;
+    }
+    return count;
+#endif
+}
+
+// Index des niederwertigsten gesetzten Bits, word != 0
+inline int ctz64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int idx = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        idx += 1;
+    }
+    return idx;
+#endif
+}
+
+// Index des höchstwertigen gesetzten Bits, word != 0
+inline int msb64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    int idx = 0;
+    while (word >>= 1) {
+        idx += 1;
+    }
+    return idx;
+#endif
+}
+
+// alle Bits ab Position bit (inklusive) gesetzt, 0 <= bit < 64
+inline uint64_t mask_from(int bit) {
+    return ~uint64_t(0) << bit;
+}
+
+// gültige Bits im letzten Wort einer Zeile mit columns Spalten
+inline uint64_t tail_mask(int columns) {
+    const int rest = columns % WORD_BITS;
+    return rest == 0 ? ~uint64_t(0) : ~mask_from(rest);
+}
+
+#endif //BUGA_PROJ_BITS_H
@@ -0,0 +1,211 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "FieldGenerator.h"
+#include "Bits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+static const int TILE = 64;     // Kachelgröße für clustered
+static const int BAND = 16;     // Bandbreite für diagonal
+static const int SPREAD = 4;    // clustered/diagonal: jede 4. Kachel bzw. jedes 4. Band, dichter mehr
+static const int SPARSE = 16;   // sparse: jede 16. Zeile, dichter mehr
+
+// SplitMix64, klein und schnell, ein Zustand je Zeile
+struct SplitMix64 {
+    uint64_t state;
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    // gleichverteilt in (0, 1]
+    double uniform() {
+        return double((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+};
+
+static uint64_t mix(uint64_t seed, uint64_t a, uint64_t b = 0) {
+    SplitMix64 rng(seed ^ (a * 0xd1b54a32d192ed03ULL) ^ (b * 0xabc98388fb8fac03ULL));
+    return rng.next();
+}
+
+static void set_bit(uint64_t* bits, long col) {
+    bits[col / WORD_BITS] |= uint64_t(1) << (col % WORD_BITS);
+}
+
+// Spalten [c0, c1) mit Wahrscheinlichkeit p belegen, geometrische Abstände,
+// Aufwand proportional zur Anzahl der Blumen
+static void fill_random(SplitMix64& rng, double p, long c0, long c1, uint64_t* bits) {
+    if (!(p > 0) || c0 >= c1) // auch NaN
+        return;
+    if (p >= 1) {
+        for (long c=c0; c < c1; ++c) {
+            set_bit(bits, c);
+        }
+        return;
+    }
+    const double scale = 1.0 / std::log1p(-p);
+    // Abstand als double vergleichen: bei winzigem p passt er nicht in long
+    auto gap = [&]() { return std::floor(std::log(rng.uniform()) * scale); };
+    for (long c = c0;; ++c) {
+        const double skip = gap();
+        if (!(skip < double(c1 - c)))
+            break;
+        c += long(skip);
+        set_bit(bits, c);
+    }
+}
+
+bool parse_layout(const std::string& name, FieldLayout& layout) {
+    for (FieldLayout candidate : {FieldLayout::uniform, FieldLayout::clustered,
+                                  FieldLayout::diagonal, FieldLayout::sparse}) {
+        if (name == layout_name(candidate)) {
+            layout = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* layout_name(FieldLayout layout) {
+    switch (layout) {
+        case FieldLayout::clustered:
+            return "clustered";
+        case FieldLayout::diagonal:
+            return "diagonal";
+        case FieldLayout::sparse:
+            return "sparse";
+        default:
+            return "uniform";
+    }
+}
+
+// Von je parts Kacheln/Bändern/Zeilen werden planted belegt, so viele wie für
+// density mit Belegungsdichte <= 1 nötig sind; planted = 1 bis density = 1/parts
+struct Planting {
+    int planted;
+    double dense; // Dichte innerhalb der belegten Teile
+};
+
+static Planting planting(double density, int parts) {
+    const double needed = (density > 0 ? std::min(density, 1.0) : 0.0) * parts; // NaN wie 0
+    const int planted = std::min(parts, std::max(1, int(std::ceil(needed))));
+    return {planted, std::min(1.0, needed / planted)};
+}
+
+void generate_row(const FieldSpec& spec, int row, uint64_t* bits) {
+    std::fill(bits, bits + words_for(spec.columns), 0);
+    SplitMix64 rng(mix(spec.seed, uint64_t(row) + 1));
+    switch (spec.layout) {
+        case FieldLayout::uniform:
+            fill_random(rng, spec.density, 0, spec.columns, bits);
+            break;
+        case FieldLayout::clustered: {
+            const Planting tiles = planting(spec.density, SPREAD);
+            for (int c0=0; c0 < spec.columns; c0 += TILE) {
+                if (mix(spec.seed, uint64_t(row / TILE), uint64_t(c0 / TILE) + 1) % SPREAD < uint64_t(tiles.planted))
+                    fill_random(rng, tiles.dense, c0, std::min(c0 + TILE, spec.columns), bits);
+            }
+            break;
+        }
+        case FieldLayout::diagonal: {
+            // Band k umfasst Zeile + Spalte in [k * BAND, (k + 1) * BAND),
+            // belegt sind die ersten planted Bänder jeder Periode
+            const Planting bands = planting(spec.density, SPREAD);
+            const long period = long(BAND) * SPREAD;
+            const long width = long(BAND) * bands.planted;
+            for (long c0 = -(long(row) % period); c0 < spec.columns; c0 += period) {
+                fill_random(rng, bands.dense, std::max(c0, 0L), std::min(c0 + width, long(spec.columns)), bits);
+            }
+            break;
+        }
+        case FieldLayout::sparse: {
+            const Planting rows = planting(spec.density, SPARSE);
+            if (mix(spec.seed, uint64_t(row) + 1, 1) % SPARSE < uint64_t(rows.planted))
+                fill_random(rng, rows.dense, 0, spec.columns, bits);
+            break;
+        }
+    }
+}
+
+// Zeilen [begin, end) in zusammenhängenden Stücken auf jobs Threads verteilen
+static void parallel_rows(int begin, int end, int jobs, const std::function<void(int, int)>& body) {
+    if (jobs <= 0)
+        jobs = int(std::max(1u, std::thread::hardware_concurrency()));
+    jobs = std::max(1, std::min(jobs, end - begin));
+    const int chunk = (end - begin + jobs - 1) / jobs;
+    std::vector<std::thread> pool;
+    for (int j=1; j < jobs; ++j) {
+        const int from = begin + j * chunk;
+        pool.emplace_back(body, from, std::min(from + chunk, end));
+    }
+    body(begin, std::min(begin + chunk, end));
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+Acker generate_field(const FieldSpec& spec, int jobs) {
+    const int words = words_for(spec.columns);
+    std::vector<uint64_t> bits(size_t(spec.rows) * words, 0);
+    if (spec.rows > 0) {
+        parallel_rows(0, spec.rows, jobs, [&](int from, int to) {
+            for (int i=from; i < to; ++i) {
+                generate_row(spec, i, bits.data() + size_t(i) * words);
+            }
+        });
+    }
+    std::string name = std::string("generated_") + layout_name(spec.layout) + "_"
+                     + std::to_string(spec.rows) + "x" + std::to_string(spec.columns);
+    return Acker(spec.rows, spec.columns, std::move(bits), name);
+}
+
+long write_field(const FieldSpec& spec, const std::string& path, int jobs) {
+    std::ofstream out(path, std::ofstream::binary);
+    if (!out) {
+        throw pbma_exception("write_field: nicht schreibbar", path);
+    }
+    const size_t line = size_t(spec.columns) + 1;
+    const int batch = int(std::max(size_t(1), (size_t(64) << 20) / line));
+    const int words = words_for(spec.columns);
+    std::vector<char> buffer;
+    long flowers = 0;
+    for (int begin=0; begin < spec.rows; begin += batch) {
+        const int end = std::min(begin + batch, spec.rows);
+        buffer.resize(size_t(end - begin) * line);
+        std::vector<long> counts(size_t(end - begin), 0);
+        parallel_rows(begin, end, jobs, [&](int from, int to) {
+            std::vector<uint64_t> bits(words);
+            for (int i=from; i < to; ++i) {
+                generate_row(spec, i, bits.data());
+                char* text = buffer.data() + size_t(i - begin) * line;
+                std::memset(text, ' ', spec.columns);
+                text[spec.columns] = '\n';
+                for (int w=0; w < words; ++w) {
+                    for (uint64_t word = bits[w]; word; word &= word - 1) {
+                        text[w * WORD_BITS + ctz64(word)] = '*';
+                    }
+                    counts[size_t(i - begin)] += popcount64(bits[w]);
+                }
+            }
+        });
+        out.write(buffer.data(), std::streamsize(buffer.size()));
+        for (const long& count : counts) {
+            flowers += count;
+        }
+    }
+    if (!out) {
+        throw pbma_exception("write_field: Schreibfehler", path);
+    }
+    return flowers;
+}
@@ -0,0 +1,43 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_FIELDGENERATOR_H
+#define BUGA_PROJ_FIELDGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include "Acker.h"
+
+// Anordnung der Blumen im erzeugten Feld, die Dichte gilt jeweils im Mittel
+// über das ganze Feld:
+// uniform   jede Zelle unabhängig mit Wahrscheinlichkeit density
+// clustered nur ein Teil der 64x64-Kacheln ist belegt, dort dichter
+// diagonal  Bänder von links unten nach rechts oben (Zeile + Spalte konstant)
+// sparse    nur jede 16. Zeile im Mittel trägt Blumen, dort dichter
+// Reicht die Dichte in den belegten Teilen nicht (density über 1/4 bzw.
+// 1/16), werden entsprechend mehr Kacheln, Bänder oder Zeilen belegt.
+enum class FieldLayout { uniform, clustered, diagonal, sparse };
+
+struct FieldSpec {
+    int rows = 0;
+    int columns = 0;
+    double density = 0.05;
+    FieldLayout layout = FieldLayout::uniform;
+    uint64_t seed = 1;
+};
+
+bool parse_layout(const std::string& name, FieldLayout& layout);
+const char* layout_name(FieldLayout layout);
+
+// Zeile row in bits (words_for(columns) Wörter) erzeugen, hängt nur von
+// spec und row ab, daher deterministisch und beliebig parallelisierbar
+void generate_row(const FieldSpec& spec, int row, uint64_t* bits);
+
+// ganzes Feld im Speicher, jobs Threads (0: alle Kerne)
+Acker generate_field(const FieldSpec& spec, int jobs = 0);
+
+// Feld als .dat-Textdatei schreiben, Rückgabe Anzahl Blumen
+long write_field(const FieldSpec& spec, const std::string& path, int jobs = 0);
+
+#endif //BUGA_PROJ_FIELDGENERATOR_H
@@ -0,0 +1,155 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "FlowerCount.h"
+#include "Bits.h"
+
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BUGA_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+static const char FLOWER = '*';
+
+// Bits von bis zu 64 Zeichen, Zeichen i ergibt Bit i
+static uint64_t scalar_word(const char* data, size_t length) {
+    uint64_t word = 0;
+    for (size_t i=0; i < length; ++i) {
+        if (data[i] == FLOWER)
+            word |= uint64_t(1) << i;
+    }
+    return word;
+}
+
+#ifdef BUGA_X86_DISPATCH
+static inline uint64_t sse2_word(const char* data) {
+    const __m128i star = _mm_set1_epi8(FLOWER);
+    uint64_t word = 0;
+    for (int k=0; k < 4; ++k) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * k));
+        const uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, star))) & 0xffff;
+        word |= uint64_t(mask) << (16 * k);
+    }
+    return word;
+}
+
+__attribute__((target("avx2")))
+static inline uint64_t avx2_word(const char* data) {
+    const __m256i star = _mm256_set1_epi8(FLOWER);
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+    const uint32_t lo_mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, star)));
+    const uint32_t hi_mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, star)));
+    return uint64_t(lo_mask) | (uint64_t(hi_mask) << 32);
+}
+
+static size_t sse2_pack(const char* data, size_t size, uint64_t* bits) {
+    size_t flowers = 0;
+    const size_t full = size / WORD_BITS;
+    for (size_t w=0; w < full; ++w) {
+        const uint64_t word = sse2_word(data + w * WORD_BITS);
+        if (bits)
+            bits[w] = word;
+        flowers += popcount64(word);
+    }
+    if (size % WORD_BITS) {
+        const uint64_t word = scalar_word(data + full * WORD_BITS, size % WORD_BITS);
+        if (bits)
+            bits[full] = word;
+        flowers += popcount64(word);
+    }
+    return flowers;
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t avx2_pack(const char* data, size_t size, uint64_t* bits) {
+    size_t flowers = 0;
+    const size_t full = size / WORD_BITS;
+    for (size_t w=0; w < full; ++w) {
+        const uint64_t word = avx2_word(data + w * WORD_BITS);
+        if (bits)
+            bits[w] = word;
+        flowers += popcount64(word);
+    }
+    if (size % WORD_BITS) {
+        const uint64_t word = scalar_word(data + full * WORD_BITS, size % WORD_BITS);
+        if (bits)
+            bits[full] = word;
+        flowers += popcount64(word);
+    }
+    return flowers;
+}
+#endif
+
+static size_t scalar_pack(const char* data, size_t size, uint64_t* bits) {
+    size_t flowers = 0;
+    for (size_t w=0; w * WORD_BITS < size; ++w) {
+        const size_t length = std::min(size - w * WORD_BITS, size_t(WORD_BITS));
+        const uint64_t word = scalar_word(data + w * WORD_BITS, length);
+        if (bits)
+            bits[w] = word;
+        flowers += popcount64(word);
+    }
+    return flowers;
+}
+
+bool engine_supported(CountEngine engine) {
+    switch (engine) {
+        case CountEngine::scalar:
+            return true;
+#ifdef BUGA_X86_DISPATCH
+        case CountEngine::sse2:
+            return __builtin_cpu_supports("sse2");
+        case CountEngine::avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+        default:
+            return false;
+    }
+}
+
+CountEngine best_count_engine() {
+    static const CountEngine best = engine_supported(CountEngine::avx2) ? CountEngine::avx2
+                                  : engine_supported(CountEngine::sse2) ? CountEngine::sse2
+                                  : CountEngine::scalar;
+    return best;
+}
+
+const char* engine_name(CountEngine engine) {
+    switch (engine) {
+        case CountEngine::sse2:
+            return "sse2";
+        case CountEngine::avx2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+size_t pack_flowers(const char* data, size_t size, uint64_t* bits, CountEngine engine) {
+    switch (engine) {
+#ifdef BUGA_X86_DISPATCH
+        case CountEngine::sse2:
+            return sse2_pack(data, size, bits);
+        case CountEngine::avx2:
+            return avx2_pack(data, size, bits);
+#endif
+        default:
+            return scalar_pack(data, size, bits);
+    }
+}
+
+size_t pack_flowers(const char* data, size_t size, uint64_t* bits) {
+    return pack_flowers(data, size, bits, best_count_engine());
+}
+
+size_t count_flowers(const char* data, size_t size, CountEngine engine) {
+    return pack_flowers(data, size, nullptr, engine);
+}
+
+size_t count_flowers(const char* data, size_t size) {
+    return pack_flowers(data, size, nullptr, best_count_engine());
+}
@@ -0,0 +1,29 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_FLOWERCOUNT_H
+#define BUGA_PROJ_FLOWERCOUNT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Zählwerk für Blumen ('*') in Textzeilen, ein Durchlauf mit
+// SIMD-Vergleichen, Auswahl der Variante zur Laufzeit.
+enum class CountEngine { scalar, sse2, avx2 };
+
+// beste vom Prozessor unterstützte Variante, einmal ermittelt
+CountEngine best_count_engine();
+bool engine_supported(CountEngine engine);
+const char* engine_name(CountEngine engine);
+
+// Anzahl der '*' in data[0..size)
+size_t count_flowers(const char* data, size_t size);
+size_t count_flowers(const char* data, size_t size, CountEngine engine);
+
+// setzt für jedes '*' in data[0..size) das zugehörige Bit in bits
+// (words_for(size) Wörter, vorher genullt), Rückgabe Anzahl Blumen
+size_t pack_flowers(const char* data, size_t size, uint64_t* bits);
+size_t pack_flowers(const char* data, size_t size, uint64_t* bits, CountEngine engine);
+
+#endif //BUGA_PROJ_FLOWERCOUNT_H
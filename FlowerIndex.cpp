@@ -0,0 +1,65 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "FlowerIndex.h"
+#include "Bits.h"
+
+#include <algorithm>
+
+FlowerIndex::FlowerIndex(const uint64_t* bits, int rows, int columns, int words, uint64_t flowers)
+        : m_rows(rows), m_columns(columns) {
+    if (flowers <= UINT16_MAX) {
+        m_entry_bytes = 2;
+        build(m_sum16, bits, words);
+    } else if (flowers <= UINT32_MAX) {
+        m_entry_bytes = 4;
+        build(m_sum32, bits, words);
+    } else {
+        m_entry_bytes = 8;
+        build(m_sum64, bits, words);
+    }
+}
+
+template <typename T>
+void FlowerIndex::build(std::vector<T>& sums, const uint64_t* bits, int words) {
+    const size_t stride = size_t(m_columns) + 1;
+    sums.assign((size_t(m_rows) + 1) * stride, 0);
+    for (int i=0; i < m_rows; ++i) {
+        const uint64_t* row = bits + size_t(i) * words;
+        const T* above = sums.data() + size_t(i) * stride;
+        T* sum = sums.data() + size_t(i + 1) * stride;
+        T in_row = 0;
+        for (int j=0; j < m_columns; ++j) {
+            in_row += T((row[j / WORD_BITS] >> (j % WORD_BITS)) & 1);
+            sum[j + 1] = above[j + 1] + in_row;
+        }
+    }
+}
+
+uint64_t FlowerIndex::at(int row, int col) const {
+    const size_t idx = size_t(row) * (size_t(m_columns) + 1) + col;
+    switch (m_entry_bytes) {
+        case 2:
+            return m_sum16[idx];
+        case 4:
+            return m_sum32[idx];
+        default:
+            return m_sum64[idx];
+    }
+}
+
+size_t FlowerIndex::memory_bytes() const {
+    return m_sum16.size() * sizeof(uint16_t) + m_sum32.size() * sizeof(uint32_t)
+         + m_sum64.size() * sizeof(uint64_t);
+}
+
+uint64_t FlowerIndex::count(int row0, int col0, int row1, int col1) const {
+    row0 = std::max(row0, 0);
+    col0 = std::max(col0, 0);
+    row1 = std::min(row1, m_rows);
+    col1 = std::min(col1, m_columns);
+    if (row0 >= row1 || col0 >= col1)
+        return 0;
+    return at(row1, col1) - at(row0, col1) - at(row1, col0) + at(row0, col0);
+}
@@ -0,0 +1,47 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_FLOWERINDEX_H
+#define BUGA_PROJ_FLOWERINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Summed-Area-Table über die bitgepackten Zeilen: Eintrag (r, c) ist die
+// Anzahl der Blumen in Zeilen [0, r) und Spalten [0, c). Damit kostet jede
+// Rechteckabfrage vier Zugriffe, O(1).
+// Aufbau: ein Durchlauf über alle Zellen, O(rows * columns).
+// Speicher: (rows + 1) * (columns + 1) Einträge zu 2, 4 oder 8 Bytes, die
+// Breite wird nach der Gesamtzahl der Blumen gewählt (<= 65535 -> 2 Bytes,
+// <= 2^32 - 1 -> 4 Bytes). Ein 512x512-Feld braucht so etwa 0.5 MB,
+// 100k x 100k aber 40 GB, daher ist der Index optional.
+class FlowerIndex {
+    int m_rows = 0;
+    int m_columns = 0;
+    int m_entry_bytes = 0;
+    std::vector<uint16_t> m_sum16;
+    std::vector<uint32_t> m_sum32;
+    std::vector<uint64_t> m_sum64;
+
+    uint64_t at(int row, int col) const;
+    template <typename T>
+    void build(std::vector<T>& sums, const uint64_t* bits, int words);
+public:
+    FlowerIndex() = default;
+    FlowerIndex(const uint64_t* bits, int rows, int columns, int words, uint64_t flowers);
+    bool empty() const { return m_entry_bytes == 0; }
+    int entry_bytes() const { return m_entry_bytes; }
+    size_t memory_bytes() const;
+    // Blumen in Zeilen [row0, row1) und Spalten [col0, col1)
+    uint64_t count(int row0, int col0, int row1, int col1) const;
+    // Blumen in Zeile row ab Spalte col
+    uint64_t row_suffix(int row, int col) const { return count(row, col, row + 1, m_columns); }
+    // Blumen aller Zeilen in den Spalten [col0, col1)
+    uint64_t columns(int col0, int col1) const { return count(0, col0, m_rows, col1); }
+    // Blumen oberhalb (Zeilen <= row) und rechts (Spalten >= col) einer Zelle
+    uint64_t above_right(int row, int col) const { return count(0, col, row + 1, m_columns); }
+};
+
+#endif //BUGA_PROJ_FLOWERINDEX_H
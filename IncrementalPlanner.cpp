@@ -0,0 +1,64 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "IncrementalPlanner.h"
+
+#include <utility>
+
+IncrementalPlanner::IncrementalPlanner(Acker acker, bool full_width)
+        : m_acker(std::move(acker)), m_full_width(full_width) {
+    for (int i=m_acker.get_rows()-1; i >= 0; --i) {
+        if (!m_acker.row_empty(i)) {
+            Tour tour = row_tour(i);
+            m_steps += tour.steps();
+            m_tours.emplace_hint(m_tours.end(), i, std::move(tour));
+        }
+    }
+}
+
+Tour IncrementalPlanner::row_tour(int row) const {
+    Tour tour;
+    tour.append(Tour::UP, (m_acker.get_rows()-1)-row);
+    tour.append(Tour::RIGHT, m_full_width ? m_acker.get_columns() : m_acker.last_flower(row) + 1);
+    return tour;
+}
+
+void IncrementalPlanner::update_row(int row) {
+    auto it = m_tours.find(row);
+    if (it == m_tours.end()) {
+        // Zeile war leer, die Änderung kann nur eine Blume hinzugefügt haben
+        Tour tour = row_tour(row);
+        m_steps += tour.steps();
+        m_tours.emplace(row, std::move(tour));
+    } else if (m_acker.row_empty(row)) {
+        m_steps -= it->second.steps();
+        m_tours.erase(it);
+    } else if (!m_full_width) {
+        // volle Breite: die Tour bleibt gleich, sonst neues Ende
+        m_steps -= it->second.steps();
+        it->second = row_tour(row);
+        m_steps += it->second.steps();
+    }
+}
+
+bool IncrementalPlanner::set_flower(int row, int col, bool flower) {
+    if (!m_acker.set_flower(row, col, flower))
+        return false;
+    update_row(row);
+    return true;
+}
+
+const Tour* IncrementalPlanner::tour_of_row(int row) const {
+    auto it = m_tours.find(row);
+    return it == m_tours.end() ? nullptr : &it->second;
+}
+
+std::vector<Tour> IncrementalPlanner::tours() const {
+    std::vector<Tour> tours;
+    tours.reserve(m_tours.size());
+    for (const auto& entry : m_tours) {
+        tours.push_back(entry.second);
+    }
+    return tours;
+}
@@ -0,0 +1,42 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_INCREMENTALPLANNER_H
+#define BUGA_PROJ_INCREMENTALPLANNER_H
+
+#include <functional>
+#include <map>
+#include <vector>
+#include "Acker.h"
+#include "Tour.h"
+
+// Hält die einfache Lösung (eine Tour je Zeile mit Blumen) eines Feldes
+// aktuell, während Blumen dazukommen oder geerntet werden. Jede Änderung
+// betrifft nur die Tour ihrer Zeile: mit full_width in O(log rows), sonst
+// fährt die Tour nur bis zur letzten Blume, das kostet zusätzlich einen
+// Durchlauf über die Wörter der Zeile.
+class IncrementalPlanner {
+    Acker m_acker;
+    bool m_full_width;
+    // Zeile -> Tour, von unten nach oben wie simple_solution
+    std::map<int, Tour, std::greater<int>> m_tours;
+    long m_steps = 0;
+
+    Tour row_tour(int row) const;
+    void update_row(int row);
+public:
+    explicit IncrementalPlanner(Acker acker, bool full_width = true);
+    // true, wenn sich das Feld geändert hat
+    bool set_flower(int row, int col, bool flower);
+    const Acker& acker() const { return m_acker; }
+    long get_flower_count() const { return m_acker.get_flower_count(); }
+    long get_steps() const { return m_steps; }
+    int get_tour_numbers() const { return int(m_tours.size()); }
+    // Tour der Zeile row, nullptr wenn die Zeile leer ist
+    const Tour* tour_of_row(int row) const;
+    // alle Touren in der Reihenfolge von simple_solution, O(Touren)
+    std::vector<Tour> tours() const;
+};
+
+#endif //BUGA_PROJ_INCREMENTALPLANNER_H
@@ -0,0 +1,183 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "OutputSink.h"
+#include "pbma.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BUGA_HAVE_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+OutputSink::OutputSink(const std::string& target) : m_buffer(BUFFER_SIZE) {
+    if (target == "null") {
+        m_null = true;
+        return;
+    }
+#ifdef BUGA_HAVE_POSIX_IO
+    if (target.empty() || target == "-") {
+        std::fflush(stdout);
+        m_fd = STDOUT_FILENO;
+    } else {
+        m_fd = open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        m_owns = true;
+    }
+    if (m_fd < 0) {
+        throw pbma_exception("OutputSink: nicht schreibbar", target);
+    }
+#else
+    if (target.empty() || target == "-") {
+        m_file = stdout;
+    } else {
+        m_file = std::fopen(target.c_str(), "wb");
+        m_owns = true;
+    }
+    if (m_file == nullptr) {
+        throw pbma_exception("OutputSink: nicht schreibbar", target);
+    }
+#endif
+}
+
+OutputSink::~OutputSink() {
+    try {
+        flush();
+    } catch (const pbma_exception&) {
+        // im Destruktor nicht werfen
+    }
+#ifdef BUGA_HAVE_POSIX_IO
+    if (m_owns)
+        close(m_fd);
+#else
+    if (m_owns)
+        std::fclose(m_file);
+#endif
+}
+
+// schreibt Puffer und data, auf POSIX mit einem writev
+void OutputSink::write_out(const char* data, size_t size) {
+    if (m_null) {
+        m_used = 0;
+        return;
+    }
+#ifdef BUGA_HAVE_POSIX_IO
+    iovec parts[2] = {{m_buffer.data(), m_used}, {const_cast<char*>(data), size}};
+    iovec* part = parts;
+    int count = size > 0 ? 2 : 1;
+    while (count > 0) {
+        const ssize_t written = writev(m_fd, part, count);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw pbma_exception("OutputSink: Schreibfehler", int(errno));
+        }
+        // teilweise geschrieben: Rest nachschieben
+        size_t rest = size_t(written);
+        while (count > 0 && rest >= part->iov_len) {
+            rest -= part->iov_len;
+            ++part;
+            --count;
+        }
+        if (count > 0) {
+            part->iov_base = static_cast<char*>(part->iov_base) + rest;
+            part->iov_len -= rest;
+        }
+    }
+#else
+    if (std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used ||
+        std::fwrite(data, 1, size, m_file) != size) {
+        throw pbma_exception("OutputSink: Schreibfehler");
+    }
+#endif
+    m_used = 0;
+}
+
+char* OutputSink::reserve(size_t size) {
+    if (m_used + size > m_buffer.size())
+        write_out(nullptr, 0);
+    char* at = m_buffer.data() + m_used;
+    m_used += size;
+    return at;
+}
+
+void OutputSink::write(const char* data, size_t size) {
+    if (m_used + size <= m_buffer.size()) {
+        std::memcpy(m_buffer.data() + m_used, data, size);
+        m_used += size;
+    } else {
+        write_out(data, size);
+    }
+}
+
+void OutputSink::put(char ch) {
+    *reserve(1) = ch;
+}
+
+void OutputSink::fill(char ch, size_t count) {
+    while (count > 0) {
+        const size_t part = std::min(count, m_buffer.size());
+        std::memset(reserve(part), ch, part);
+        count -= part;
+    }
+}
+
+void OutputSink::flush() {
+    if (m_used > 0)
+        write_out(nullptr, 0);
+#ifndef BUGA_HAVE_POSIX_IO
+    if (m_file != nullptr)
+        std::fflush(m_file);
+#endif
+}
+
+OutputSink& operator<<(OutputSink& out, std::string_view text) {
+    out.write(text);
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, const char* text) {
+    out.write(std::string_view(text));
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, const std::string& text) {
+    out.write(text.data(), text.size());
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, char ch) {
+    out.put(ch);
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, long value) {
+    char digits[24];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.write(digits, size_t(result.ptr - digits));
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, unsigned long value) {
+    char digits[24];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.write(digits, size_t(result.ptr - digits));
+    return out;
+}
+
+OutputSink& operator<<(OutputSink& out, int value) {
+    return out << long(value);
+}
+
+OutputSink& operator<<(OutputSink& out, const Tour& tour) {
+    for (const Tour::Run& run : tour.runs()) {
+        out.fill(run.move, size_t(run.count));
+    }
+    return out;
+}
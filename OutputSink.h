@@ -0,0 +1,57 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_OUTPUTSINK_H
+#define BUGA_PROJ_OUTPUTSINK_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Tour.h"
+
+// Gepufferte Ausgabe für Touren und Berichte. Formatiert in einen großen
+// Puffer und schreibt ihn erst, wenn er voll ist, mit einem write; passt ein
+// großes Stück nicht mehr hinein, gehen Puffer und Stück mit einem writev
+// raus. Ziel je Lauf: "-" stdout, "null" verwirft alles (für Messungen),
+// sonst ein Dateiname. Ohne POSIX wird über stdio geschrieben.
+class OutputSink {
+    int m_fd = -1;
+    std::FILE* m_file = nullptr; // nur ohne POSIX
+    bool m_null = false;
+    bool m_owns = false;
+    std::vector<char> m_buffer;
+    size_t m_used = 0;
+
+    void write_out(const char* data, size_t size);
+    char* reserve(size_t size);
+public:
+    static constexpr size_t BUFFER_SIZE = size_t(1) << 20;
+
+    explicit OutputSink(const std::string& target = "-");
+    ~OutputSink();
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    void write(const char* data, size_t size);
+    void write(std::string_view text) { write(text.data(), text.size()); }
+    void put(char ch);
+    // count gleiche Zeichen ohne Zwischenstring
+    void fill(char ch, size_t count);
+    void flush();
+    bool is_null() const { return m_null; }
+};
+
+OutputSink& operator<<(OutputSink& out, std::string_view text);
+OutputSink& operator<<(OutputSink& out, const char* text);
+OutputSink& operator<<(OutputSink& out, const std::string& text);
+OutputSink& operator<<(OutputSink& out, char ch);
+OutputSink& operator<<(OutputSink& out, long value);
+OutputSink& operator<<(OutputSink& out, unsigned long value);
+OutputSink& operator<<(OutputSink& out, int value);
+// expandiert die Läufe direkt in den Puffer
+OutputSink& operator<<(OutputSink& out, const Tour& tour);
+
+#endif //BUGA_PROJ_OUTPUTSINK_H
@@ -0,0 +1,76 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+static std::mutex profile_mutex;
+static std::map<std::string, std::vector<long>> profile_samples;
+// geöffnete Scopes des Threads
+static thread_local std::vector<const char*> scope_stack;
+
+void ProfileScope::begin(const char* name) {
+    scope_stack.push_back(name);
+    m_time.emplace();
+}
+
+void ProfileScope::end() {
+    const long ns = m_time->measure_net_ns();
+    std::string path;
+    for (const char* name : scope_stack) {
+        if (!path.empty())
+            path += '/';
+        path += name;
+    }
+    scope_stack.pop_back();
+    Profiler::record(path, ns);
+}
+
+void Profiler::enable(bool on) {
+    if (on)
+        Timer::overhead_ns();
+    s_enabled = on;
+}
+
+void Profiler::record(const std::string& path, long ns) {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    profile_samples[path].push_back(ns);
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    profile_samples.clear();
+}
+
+static std::string seconds(long ns) {
+    return Timer::human_format(double(ns) * 1e-9);
+}
+
+void Profiler::report(OutputSink& out) {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    if (profile_samples.empty())
+        return;
+    out << "Profil: Phase, Anzahl, Summe, Min, Max, p50, p95\n";
+    for (auto& entry : profile_samples) {
+        const std::string& path = entry.first;
+        std::vector<long>& samples = entry.second;
+        std::sort(samples.begin(), samples.end());
+        long total = 0;
+        for (const long& ns : samples) {
+            total += ns;
+        }
+        // eingerückt nach Tiefe, nur der letzte Name
+        const size_t depth = size_t(std::count(path.begin(), path.end(), '/'));
+        const size_t slash = path.rfind('/');
+        std::string name(2 * (depth + 1), ' ');
+        name += slash == std::string::npos ? path : path.substr(slash + 1);
+        name.resize(std::max(name.size(), size_t(24)), ' ');
+        out << name << format(long(samples.size()), 7) << "  " << seconds(total) << "  " << seconds(samples.front())
+            << "  " << seconds(samples.back()) << "  " << seconds(percentile_sorted(samples, 0.5)) << "  " << seconds(percentile_sorted(samples, 0.95)) << '\n';
+    }
+}
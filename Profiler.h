@@ -0,0 +1,49 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_PROFILER_H
+#define BUGA_PROJ_PROFILER_H
+
+#include <optional>
+#include <string>
+#include "pbma.h"
+#include "OutputSink.h"
+
+// Sammelt benannte Phasen hierarchisch über alle Felder und Threads. Der
+// Pfad einer Phase ergibt sich aus den geöffneten Scopes des Threads, z.B.
+// "load/parse". Je Pfad werden alle Dauern gehalten, report gibt Anzahl,
+// Summe, Min, Max, p50 und p95 aus. Ausgeschaltet kostet ein Scope nur
+// einen Test auf ein bool, es wird keine Uhr gelesen.
+class Profiler {
+    inline static bool s_enabled = false;
+public:
+    // vor dem Start der Threads setzen; kalibriert beim Einschalten die
+    // Timer-Kosten, damit das nicht im ersten Scope mitgemessen wird
+    static void enable(bool on = true);
+    static bool enabled() { return s_enabled; }
+    static void record(const std::string& path, long ns);
+    static void report(OutputSink& out);
+    static void reset();
+};
+
+// RAII: misst vom Konstruktor bis zum Destruktor, name muss so lange leben
+class ProfileScope {
+    std::optional<Timer> m_time;
+
+    void begin(const char* name);
+    void end();
+public:
+    explicit ProfileScope(const char* name) {
+        if (Profiler::enabled())
+            begin(name);
+    }
+    ~ProfileScope() {
+        if (m_time)
+            end();
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#endif //BUGA_PROJ_PROFILER_H
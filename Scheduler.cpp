@@ -0,0 +1,116 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+long Schedule::makespan() const {
+    return loads.empty() ? 0 : *std::max_element(loads.begin(), loads.end());
+}
+
+// ein Verbesserungsschritt zwischen vollster und leerster Maschine,
+// false, wenn weder Verschieben noch Tauschen hilft
+static bool improve(Schedule& schedule, const std::vector<long>& steps) {
+    const auto by_load = std::minmax_element(schedule.loads.begin(), schedule.loads.end());
+    const size_t low = size_t(by_load.first - schedule.loads.begin());
+    const size_t high = size_t(by_load.second - schedule.loads.begin());
+    const long diff = *by_load.second - *by_load.first;
+    if (diff <= 1)
+        return false;
+
+    auto by_steps = [&](size_t a, size_t b) { return steps[a] < steps[b]; };
+    std::vector<size_t>& full = schedule.tours[high];
+    std::vector<size_t>& empty = schedule.tours[low];
+    std::sort(full.begin(), full.end(), by_steps);
+    std::sort(empty.begin(), empty.end(), by_steps);
+
+    // delta = a - b wandert von high nach low, ideal ist diff / 2
+    long best_score = diff;
+    size_t best_full = full.size();
+    size_t best_empty = empty.size(); // == size: verschieben statt tauschen
+    auto consider = [&](size_t i, size_t j, long delta) {
+        if (delta <= 0 || delta >= diff)
+            return;
+        const long score = std::abs(diff - 2 * delta);
+        if (score < best_score) {
+            best_score = score;
+            best_full = i;
+            best_empty = j;
+        }
+    };
+    for (size_t i=0; i < full.size(); ++i) {
+        const long a = steps[full[i]];
+        consider(i, empty.size(), a);
+        const long target = a - diff / 2;
+        auto it = std::lower_bound(empty.begin(), empty.end(), target,
+                                   [&](size_t idx, long value) { return steps[idx] < value; });
+        if (it != empty.end())
+            consider(i, size_t(it - empty.begin()), a - steps[*it]);
+        if (it != empty.begin())
+            consider(i, size_t(it - empty.begin()) - 1, a - steps[*(it - 1)]);
+    }
+    if (best_full == full.size())
+        return false;
+
+    const size_t moved = full[best_full];
+    long delta = steps[moved];
+    if (best_empty < empty.size()) {
+        const size_t back = empty[best_empty];
+        delta -= steps[back];
+        full[best_full] = back;
+        empty[best_empty] = moved;
+    } else {
+        full[best_full] = full.back();
+        full.pop_back();
+        empty.push_back(moved);
+    }
+    schedule.loads[high] -= delta;
+    schedule.loads[low] += delta;
+    return true;
+}
+
+Schedule schedule_tours(const std::vector<long>& steps, int harvesters, int max_rounds) {
+    Schedule schedule;
+    harvesters = std::max(harvesters, 1);
+    schedule.tours.resize(size_t(harvesters));
+    schedule.loads.assign(size_t(harvesters), 0);
+
+    std::vector<size_t> order(steps.size());
+    for (size_t i=0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return steps[a] > steps[b]; });
+
+    typedef std::pair<long, size_t> load_t; // (Last, Maschine)
+    std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t>> machines;
+    for (size_t h=0; h < size_t(harvesters); ++h) {
+        machines.push({0, h});
+    }
+    for (const size_t& t : order) {
+        load_t least = machines.top();
+        machines.pop();
+        schedule.tours[least.second].push_back(t);
+        least.first += steps[t];
+        schedule.loads[least.second] = least.first;
+        machines.push(least);
+    }
+
+    for (int round=0; round < max_rounds && improve(schedule, steps); ++round) {
+    }
+    return schedule;
+}
+
+Schedule schedule_tours(const std::vector<Tour>& tours, int harvesters, int max_rounds) {
+    std::vector<long> steps;
+    steps.reserve(tours.size());
+    for (const Tour& tour : tours) {
+        steps.push_back(tour.steps());
+    }
+    return schedule_tours(steps, harvesters, max_rounds);
+}
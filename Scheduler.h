@@ -0,0 +1,27 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_SCHEDULER_H
+#define BUGA_PROJ_SCHEDULER_H
+
+#include <cstddef>
+#include <vector>
+#include "Tour.h"
+
+// Verteilung der Touren auf mehrere Erntemaschinen, Ziel ist ein kleiner
+// Makespan (Schritte der am längsten beschäftigten Maschine).
+struct Schedule {
+    std::vector<std::vector<size_t>> tours; // Tour-Indizes je Maschine
+    std::vector<long> loads;                // Schritte je Maschine
+    long makespan() const;
+};
+
+// LPT: Touren absteigend nach Schritten, jeweils an die Maschine mit der
+// geringsten Last (O(n log n)). Danach lokale Verbesserung: eine Tour von
+// der vollsten zur leersten Maschine verschieben oder zwei Touren tauschen,
+// solange der Makespan sinkt, höchstens max_rounds Runden.
+Schedule schedule_tours(const std::vector<long>& steps, int harvesters, int max_rounds = 1000);
+Schedule schedule_tours(const std::vector<Tour>& tours, int harvesters, int max_rounds = 1000);
+
+#endif //BUGA_PROJ_SCHEDULER_H
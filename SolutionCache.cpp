@@ -0,0 +1,234 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "SolutionCache.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+static const char MAGIC[8] = {'B', 'U', 'G', 'A', 'S', 'O', 'L', '1'};
+// erhöhen, sobald ein Planer andere Touren liefert oder sich das Format
+// ändert; Dateien mit anderer Version gelten als Fehlschlag
+static const uint64_t VERSION = 2;
+
+struct CacheHeader {
+    char magic[8];
+    uint64_t version;
+    uint64_t hash;
+    uint64_t rows;
+    uint64_t columns;
+    uint64_t flowers;
+    int64_t steps;
+    uint64_t tours;
+};
+
+static uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 33);
+}
+
+uint64_t field_hash(const Acker& acker) {
+    uint64_t h = mix64(uint64_t(acker.get_rows()) * 0x9e3779b97f4a7c15ULL ^ uint64_t(acker.get_columns()));
+    const size_t words = size_t(acker.get_rows()) * acker.get_words();
+    const uint64_t* bits = acker.get_rows() > 0 ? acker.row_bits(0) : nullptr;
+    // vier unabhängige Ketten, damit die Multiplikationen überlappen
+    uint64_t lanes[4] = {h, h ^ 1, h ^ 2, h ^ 3};
+    size_t i = 0;
+    for (; i + 4 <= words; i += 4) {
+        for (int k=0; k < 4; ++k) {
+            lanes[k] = (lanes[k] ^ bits[i + k]) * 0x9fb21c651e98df25ULL;
+            lanes[k] ^= lanes[k] >> 29;
+        }
+    }
+    for (; i < words; ++i) {
+        lanes[0] = (lanes[0] ^ bits[i]) * 0x9fb21c651e98df25ULL;
+        lanes[0] ^= lanes[0] >> 29;
+    }
+    for (const uint64_t& lane : lanes) {
+        h = mix64(h ^ lane);
+    }
+    return h;
+}
+
+SolutionCache::SolutionCache(std::string dir, uint64_t max_bytes)
+        : m_dir(std::move(dir)), m_max_bytes(max_bytes) {
+    std::error_code error;
+    fs::create_directories(m_dir, error);
+    if (error || !fs::is_directory(m_dir)) {
+        throw pbma_exception("SolutionCache: Verzeichnis nicht anlegbar", m_dir);
+    }
+    // Grenze auch ohne store durchsetzen, z.B. nach kleinerem --cache-size
+    evict();
+}
+
+std::string SolutionCache::path_of(uint64_t hash, const std::string& planner) const {
+    static const char HEX[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (int i=15; i >= 0; --i, hash >>= 4) {
+        name[size_t(i)] = HEX[hash & 15];
+    }
+    return (fs::path(m_dir) / (name + "_" + planner + ".sol")).string();
+}
+
+bool SolutionCache::lookup(const Acker& acker, const std::string& planner,
+                           std::vector<Tour>& tours, long& steps, int& tour_numbers) {
+    const uint64_t hash = field_hash(acker);
+    const std::string path = path_of(hash, planner);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ifstream in(path, std::ifstream::binary);
+    CacheHeader header;
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.hash != hash
+        || header.rows != uint64_t(acker.get_rows()) || header.columns != uint64_t(acker.get_columns())
+        || header.flowers != uint64_t(acker.get_flower_count())) {
+        m_misses += 1;
+        return false;
+    }
+    // Anzahlen aus der Datei gegen ihre Größe prüfen, bevor allokiert wird:
+    // je Tour mindestens die Laufzahl, je Lauf ein Zug und eine Anzahl
+    const uint64_t RUN_BYTES = sizeof(char) + sizeof(int64_t);
+    std::error_code size_error;
+    const uint64_t file_size = fs::file_size(path, size_error);
+    uint64_t rest = size_error || file_size < sizeof(header) ? 0 : file_size - sizeof(header);
+    if (header.tours > uint64_t(INT_MAX) || header.tours > rest / sizeof(uint64_t)) {
+        m_misses += 1;
+        return false;
+    }
+    rest -= header.tours * sizeof(uint64_t);
+    std::vector<Tour> result(header.tours);
+    int64_t total_steps = 0;
+    std::vector<char> moves;
+    std::vector<int64_t> counts;
+    for (Tour& tour : result) {
+        uint64_t runs = 0;
+        in.read(reinterpret_cast<char*>(&runs), sizeof(runs));
+        if (!in || runs > rest / RUN_BYTES) {
+            in.setstate(std::ios::failbit);
+            break;
+        }
+        rest -= runs * RUN_BYTES;
+        moves.resize(runs);
+        counts.resize(runs);
+        in.read(moves.data(), std::streamsize(runs));
+        in.read(reinterpret_cast<char*>(counts.data()), std::streamsize(runs * sizeof(int64_t)));
+        if (!in)
+            break;
+        for (uint64_t r=0; r < runs; ++r) {
+            // Schritte müssen in Summe header.steps ergeben
+            if (counts[r] < 0 || counts[r] > header.steps - total_steps) {
+                in.setstate(std::ios::failbit);
+                break;
+            }
+            total_steps += counts[r];
+            tour.append(moves[r], long(counts[r]));
+        }
+        if (!in)
+            break;
+    }
+    if (!in || total_steps != header.steps) {
+        // abgeschnittene oder beschädigte Datei, beim nächsten store überschrieben
+        m_misses += 1;
+        return false;
+    }
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    tours = std::move(result);
+    steps += long(header.steps);
+    tour_numbers += int(header.tours);
+    m_hits += 1;
+    return true;
+}
+
+void SolutionCache::store(const Acker& acker, const std::string& planner,
+                          const std::vector<Tour>& tours) {
+    const uint64_t hash = field_hash(acker);
+    const std::string path = path_of(hash, planner);
+    CacheHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.hash = hash;
+    header.rows = uint64_t(acker.get_rows());
+    header.columns = uint64_t(acker.get_columns());
+    header.flowers = uint64_t(acker.get_flower_count());
+    // aus den geschriebenen Touren, nicht aus Zählern des Aufrufers
+    header.steps = 0;
+    for (const Tour& tour : tours) {
+        header.steps += tour.steps();
+    }
+    header.tours = uint64_t(tours.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // erst in eine temporäre Datei, dann umbenennen: kein halber Eintrag
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ofstream::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<char> moves;
+        std::vector<int64_t> counts;
+        for (const Tour& tour : tours) {
+            const uint64_t runs = tour.runs().size();
+            moves.clear();
+            counts.clear();
+            for (const Tour::Run& run : tour.runs()) {
+                moves.push_back(run.move);
+                counts.push_back(run.count);
+            }
+            out.write(reinterpret_cast<const char*>(&runs), sizeof(runs));
+            out.write(moves.data(), std::streamsize(runs));
+            out.write(reinterpret_cast<const char*>(counts.data()), std::streamsize(runs * sizeof(int64_t)));
+        }
+        if (!out) {
+            std::error_code error;
+            fs::remove(temp, error);
+            return;
+        }
+    }
+    std::error_code error;
+    fs::rename(temp, path, error);
+    if (error) {
+        fs::remove(temp, error);
+        return;
+    }
+    m_stores += 1;
+    evict();
+}
+
+// älteste Einträge löschen, bis der Inhalt wieder in max_bytes passt
+void SolutionCache::evict() {
+    struct Entry {
+        fs::file_time_type time;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (const fs::directory_entry& file : fs::directory_iterator(m_dir, error)) {
+        if (file.path().extension() != ".sol" || !file.is_regular_file(error))
+            continue;
+        const uint64_t size = file.file_size(error);
+        entries.push_back({file.last_write_time(error), size, file.path()});
+        total += size;
+    }
+    if (total <= m_max_bytes)
+        return;
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const Entry& entry : entries) {
+        if (total <= m_max_bytes)
+            break;
+        if (fs::remove(entry.path, error)) {
+            total -= entry.size;
+            m_evictions += 1;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_SOLUTIONCACHE_H
+#define BUGA_PROJ_SOLUTIONCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Acker.h"
+#include "Tour.h"
+
+// schneller 64-Bit-Hash über Größe und gepackte Zeilen, ein Schritt je Wort
+uint64_t field_hash(const Acker& acker);
+
+// Lösungen auf der Platte, eine Datei je (Feld-Hash, Planer) im Verzeichnis,
+// z.B. "3f2a...e1_min_tour.sol". Gespeichert werden Touren (als Läufe),
+// Schritte und Tourenzahl, dazu Zeilen, Spalten und Blumen gegen Kollisionen
+// und eine Version, die veraltete Einträge nach Planeränderungen verwirft.
+// Übersteigt der Inhalt max_bytes, werden beim Anlegen und nach jedem store
+// die am längsten nicht benutzten Dateien (mtime, ein Treffer erneuert sie)
+// gelöscht. Threadsicher.
+class SolutionCache {
+    std::string m_dir;
+    uint64_t m_max_bytes;
+    std::mutex m_mutex;
+    long m_hits = 0;
+    long m_misses = 0;
+    long m_stores = 0;
+    long m_evictions = 0;
+
+    std::string path_of(uint64_t hash, const std::string& planner) const;
+    void evict();
+public:
+    SolutionCache(std::string dir, uint64_t max_bytes);
+    // true bei Treffer, dann sind tours, steps und tour_numbers gesetzt
+    bool lookup(const Acker& acker, const std::string& planner,
+                std::vector<Tour>& tours, long& steps, int& tour_numbers);
+    // Schritte und Tourenzahl werden aus tours bestimmt
+    void store(const Acker& acker, const std::string& planner, const std::vector<Tour>& tours);
+    long get_hits() const { return m_hits; }
+    long get_misses() const { return m_misses; }
+    long get_stores() const { return m_stores; }
+    long get_evictions() const { return m_evictions; }
+};
+
+#endif //BUGA_PROJ_SOLUTIONCACHE_H
@@ -0,0 +1,98 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "StreamSolver.h"
+#include "FlowerCount.h"
+#include "pbma.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+// Breite der ersten Zeile, die weder leer noch Kommentar ist, vorwärts gelesen
+static size_t first_line_width(std::ifstream& in, std::string& block) {
+    bool line_start = true;
+    bool comment = false;
+    size_t length = 0;
+    in.seekg(0);
+    while (in) {
+        in.read(&block[0], std::streamsize(block.size()));
+        const size_t n = size_t(in.gcount());
+        for (size_t i=0; i < n; ++i) {
+            const char ch = block[i];
+            if (ch == '\n') {
+                if (!comment && length > 0)
+                    return length;
+                line_start = true;
+                comment = false;
+                length = 0;
+                continue;
+            }
+            if (line_start) {
+                comment = ch == '#';
+                line_start = false;
+            }
+            length += 1;
+        }
+    }
+    return comment ? 0 : length;
+}
+
+void stream_simple_solution(const std::string& path, const TourSink& sink,
+                            long& steps, int& tour_numbers, size_t block_size) {
+    std::ifstream in(path, std::ifstream::binary);
+    if (!in) {
+        throw pbma_exception("stream_simple_solution: nicht lesbar", path);
+    }
+    // ein einziger Puffer: vorne der neue Block, dahinter das Ende der
+    // Zeile, deren Anfang im Block liegt (carry); wächst nur für Zeilen,
+    // die zusammen mit dem Block nicht hineinpassen
+    std::string buffer(std::max(block_size, size_t(1)), '\0');
+    const size_t block = buffer.size();
+    const size_t columns = first_line_width(in, buffer);
+    in.clear();
+    in.seekg(0, std::ifstream::end);
+    size_t pos = size_t(in.tellg());
+
+    long from_bottom = 0;
+    auto handle = [&](std::string_view line) {
+        if (line.empty() || line[0] == '#')
+            return;
+        if (count_flowers(line.data(), std::min(line.size(), columns)) > 0) {
+            Tour tour;
+            tour.append(Tour::UP, from_bottom);
+            tour.append(Tour::RIGHT, long(columns));
+            steps += tour.steps();
+            tour_numbers += 1;
+            sink(tour);
+        }
+        from_bottom += 1;
+    };
+
+    // carry Bytes am Anfang von buffer: Ende einer Zeile, deren Anfang im
+    // nächsten (früheren) Block liegt
+    size_t carry = 0;
+    while (pos > 0) {
+        const size_t length = std::min(block, pos);
+        pos -= length;
+        if (buffer.size() < length + carry)
+            buffer.resize(length + carry);
+        std::memmove(&buffer[length], &buffer[0], carry);
+        in.seekg(std::streamoff(pos));
+        in.read(&buffer[0], std::streamsize(length));
+
+        const std::string_view view(buffer.data(), length + carry);
+        size_t end = view.size();
+        while (end > 0) {
+            const size_t nl = view.rfind('\n', end - 1);
+            if (nl == std::string_view::npos)
+                break;
+            handle(view.substr(nl + 1, end - nl - 1));
+            end = nl;
+        }
+        carry = end; // bleibt am Anfang von buffer stehen
+    }
+    handle(std::string_view(buffer.data(), carry));
+}
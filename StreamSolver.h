@@ -0,0 +1,24 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_STREAMSOLVER_H
+#define BUGA_PROJ_STREAMSOLVER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "Tour.h"
+
+typedef std::function<void(const Tour&)> TourSink;
+
+// einfache Lösung wie Acker::simple_solution, aber ohne das Feld zu laden:
+// die Datei wird blockweise vom Ende her gelesen (Zeilen rückwärts), jede
+// Tour wird sofort an sink übergeben. Ein einziger, wiederverwendeter Puffer
+// hält einen Block plus das Stück einer über Blockgrenzen reichenden Zeile,
+// unabhängig von der Anzahl der Zeilen.
+void stream_simple_solution(const std::string& path, const TourSink& sink,
+                            long& steps, int& tour_numbers,
+                            size_t block_size = size_t(1) << 20);
+
+#endif //BUGA_PROJ_STREAMSOLVER_H
@@ -0,0 +1,56 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "Tour.h"
+
+#include <algorithm>
+
+Tour::Tour(const std::string& moves) {
+    for (const char& ch : moves) {
+        append(ch);
+    }
+}
+
+void Tour::append(char move, long count) {
+    if (count <= 0)
+        return;
+    if (!m_runs.empty() && m_runs.back().move == move) {
+        m_runs.back().count += count;
+    } else {
+        m_runs.push_back({move, count});
+    }
+}
+
+long Tour::steps() const {
+    long steps = 0;
+    for (const Run& run : m_runs) {
+        steps += run.count;
+    }
+    return steps;
+}
+
+std::string Tour::to_string() const {
+    std::string moves;
+    moves.reserve(size_t(steps()));
+    for (const Run& run : m_runs) {
+        moves.append(size_t(run.count), run.move);
+    }
+    return moves;
+}
+
+void Tour::write(std::ostream& out) const {
+    constexpr long CHUNK = 4096;
+    char chunk[CHUNK];
+    for (const Run& run : m_runs) {
+        std::fill(chunk, chunk + std::min(run.count, CHUNK), run.move);
+        for (long done = 0; done < run.count; done += CHUNK) {
+            out.write(chunk, std::min(run.count - done, CHUNK));
+        }
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const Tour& tour) {
+    tour.write(out);
+    return out;
+}
@@ -0,0 +1,42 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_TOUR_H
+#define BUGA_PROJ_TOUR_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Tour als Lauflängenkodierung (Bewegung, Anzahl) statt einem Zeichen
+// je Schritt, die Zeichenkette "ooorr" wird zu {o,3},{r,2}.
+class Tour {
+public:
+    static constexpr char UP = 'o';
+    static constexpr char RIGHT = 'r';
+
+    struct Run {
+        char move;
+        long count;
+    };
+private:
+    std::vector<Run> m_runs;
+public:
+    Tour() = default;
+    // aus der Zeichenkettenform, z.B. "oorrr"
+    explicit Tour(const std::string& moves);
+    // hängt count Schritte move an, gleiche Bewegung verlängert den letzten Lauf
+    void append(char move, long count = 1);
+    const std::vector<Run>& runs() const { return m_runs; }
+    bool empty() const { return m_runs.empty(); }
+    long steps() const;
+    // expandiert in die alte Zeichenkettenform, nur bei Bedarf verwenden
+    std::string to_string() const;
+    // expandiert blockweise in den Strom, ohne die ganze Zeichenkette
+    void write(std::ostream& out) const;
+};
+
+std::ostream& operator<<(std::ostream& out, const Tour& tour);
+
+#endif //BUGA_PROJ_TOUR_H
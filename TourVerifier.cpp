@@ -0,0 +1,78 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#include "TourVerifier.h"
+#include "Bits.h"
+
+#include <algorithm>
+
+// Spalten [col0, col1) der Zeile löschen, gibt die Anzahl gelöschter Blumen zurück
+static long clear_range(uint64_t* bits, long col0, long col1) {
+    long cleared = 0;
+    const long first = col0 / WORD_BITS;
+    const long last = (col1 - 1) / WORD_BITS;
+    for (long w=first; w <= last; ++w) {
+        uint64_t mask = ~uint64_t(0);
+        if (w == first)
+            mask &= mask_from(int(col0 % WORD_BITS));
+        if (w == last)
+            mask &= tail_mask(int(col1));
+        cleared += popcount64(bits[w] & mask);
+        bits[w] &= ~mask;
+    }
+    return cleared;
+}
+
+Verification verify_tours(const Acker& acker, const std::vector<Tour>& tours) {
+    Verification result;
+    const long rows = acker.get_rows();
+    const long columns = acker.get_columns();
+    const int words = acker.get_words();
+    std::vector<uint64_t> rest;
+    if (rows > 0)
+        rest.assign(acker.row_bits(0), acker.row_bits(0) + size_t(rows) * words);
+
+    for (const Tour& tour : tours) {
+        long row = rows - 1;
+        long col = -1;
+        for (const Tour::Run& run : tour.runs()) {
+            result.steps += run.count;
+            if (run.move == Tour::RIGHT) {
+                const long inside = row < 0 ? 0 : std::max(0L, std::min(col + run.count, columns - 1) - col);
+                result.out_of_bounds += run.count - inside;
+                if (inside > 0)
+                    result.harvested += clear_range(rest.data() + size_t(row) * words, col + 1, col + 1 + inside);
+                col += run.count;
+            } else if (run.move == Tour::UP) {
+                const long inside = std::max(0L, std::min(run.count, row));
+                result.out_of_bounds += run.count - inside;
+                if (col >= columns) {
+                    result.out_of_bounds += inside;
+                } else if (col >= 0) {
+                    const uint64_t bit = uint64_t(1) << (col % WORD_BITS);
+                    uint64_t* word = rest.data() + size_t(row - 1) * words + col / WORD_BITS;
+                    for (long k=0; k < inside; ++k, word -= words) {
+                        result.harvested += (*word & bit) != 0;
+                        *word &= ~bit;
+                    }
+                }
+                row -= run.count;
+            } else {
+                result.invalid_moves += run.count;
+            }
+        }
+        result.tours += 1;
+    }
+    result.leftover = acker.get_flower_count() - result.harvested;
+    return result;
+}
+
+Verification verify_tours(const Acker& acker, const std::vector<std::string>& tours) {
+    std::vector<Tour> runs;
+    runs.reserve(tours.size());
+    for (const std::string& tour : tours) {
+        runs.emplace_back(tour);
+    }
+    return verify_tours(acker, runs);
+}
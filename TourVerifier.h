@@ -0,0 +1,33 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+#ifndef BUGA_PROJ_TOURVERIFIER_H
+#define BUGA_PROJ_TOURVERIFIER_H
+
+#include <string>
+#include <vector>
+#include "Acker.h"
+#include "Tour.h"
+
+struct Verification {
+    long harvested = 0;      // eingesammelte Blumen
+    long leftover = 0;       // nach allen Touren noch auf dem Feld
+    long steps = 0;          // Schritte aller Touren
+    long out_of_bounds = 0;  // Schritte, die außerhalb des Feldes enden
+    long invalid_moves = 0;  // Zeichen außer 'o' und 'r'
+    int tours = 0;
+    bool ok() const { return leftover == 0 && out_of_bounds == 0 && invalid_moves == 0; }
+};
+
+// Spielt die Touren auf einer Kopie der gepackten Zeilen nach. Jede Tour
+// startet unten links außerhalb des Feldes (Zeile rows - 1, Spalte -1), die
+// Spalte -1 ist die Zufahrt und gehört nicht zum Feld. Ein 'r'-Lauf löscht
+// die überfahrenen Spalten mit Wortmasken, ein 'o'-Lauf ein Bit je Zeile.
+// Kosten: O(rows * words) für die Kopie plus O(Läufe + senkrechte Schritte
+// innerhalb des Feldes + überfahrene Wörter).
+Verification verify_tours(const Acker& acker, const std::vector<Tour>& tours);
+// für Touren in der Zeichenkettenform
+Verification verify_tours(const Acker& acker, const std::vector<std::string>& tours);
+
+#endif //BUGA_PROJ_TOURVERIFIER_H
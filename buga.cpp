@@ -1,41 +1,274 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
 #include "pbma.h"
 #include "Acker.h"
+#include "StreamSolver.h"
+#include "FieldGenerator.h"
+#include "BinaryField.h"
+#include "Scheduler.h"
+#include "TourVerifier.h"
+#include "OutputSink.h"
+#include "SolutionCache.h"
+#include "Profiler.h"
 
-void aufg_1(const std::vector<Acker>& data, bool show_files) {
-    for (Acker acker : data) {
-        acker.print_out(show_files);
+// Acker-Methoden wie &Acker::simple_solution oder Lambdas mit weiteren Parametern
+typedef std::function<std::vector<Tour>(const Acker&, long& steps, int& tour_numbers)> planner_t;
+
+struct RunOptions {
+    int jobs = 1;
+    int harvesters = 0; // > 0: Touren auf Erntemaschinen verteilen
+    int capacity = 0;   // > 0: höchstens so viele Blumen je Tour (aufg 4)
+    bool verify = false; // Touren auf dem Feld nachspielen
+    SolutionCache* cache = nullptr; // --cache=verzeichnis
+};
+
+struct Solution {
+    std::vector<Tour> tours;
+    long steps = 0;
+    int tour_numbers = 0;
+    std::string time;
+};
+
+// löst alle Felder mit options.jobs Threads, Ergebnisse in Eingabereihenfolge,
+// jedes Feld wird im lösenden Thread einzeln gemessen. Mit Cache wird unter
+// dem Planernamen nachgeschlagen und nur bei einem Fehlschlag gelöst.
+std::vector<Solution> solve_all(const std::vector<Acker>& data, planner_t planner, const std::string& name,
+                                const RunOptions& options) {
+    std::vector<Solution> solutions(data.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < data.size(); i = next++) {
+            Solution& solution = solutions[i];
+            // time
+            Timer time;
+            ProfileScope solve("solve");
+            ProfileScope phase(name.c_str());
+            if (options.cache == nullptr
+                || !options.cache->lookup(data[i], name, solution.tours, solution.steps, solution.tour_numbers)) {
+                solution.tours = planner(data[i], solution.steps, solution.tour_numbers);
+                if (options.cache != nullptr)
+                    options.cache->store(data[i], name, solution.tours);
+            }
+            solution.time = time.human_measure();
+        }
+    };
+    const int jobs = std::max(1, std::min(options.jobs, int(data.size())));
+    std::vector<std::thread> pool;
+    for (int j=1; j < jobs; ++j) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return solutions;
+}
+
+void print_solution(OutputSink& out, const std::string& name, const Solution& solution) {
+    out << name << ": " << solution.tour_numbers << " Tour(en), " << solution.steps << " Schritte, " << solution.time << '\n';
+}
+
+void print_schedule(OutputSink& out, const Solution& solution, int harvesters) {
+    Timer time;
+    ProfileScope scope("schedule");
+    Schedule schedule = schedule_tours(solution.tours, harvesters);
+    out << "Erntemaschinen: " << harvesters << ", Makespan: " << schedule.makespan() << " Schritte, " << time.human_measure() << '\n';
+    for (size_t h=0; h < schedule.tours.size(); ++h) {
+        out << "  Maschine " << h << ": " << schedule.tours[h].size() << " Tour(en), " << schedule.loads[h] << " Schritte\n";
+    }
+}
+
+void print_verification(OutputSink& out, const Acker& acker, const Solution& solution) {
+    Timer time;
+    ProfileScope scope("verify");
+    const Verification check = verify_tours(acker, solution.tours);
+    out << "Pruefung: " << (check.ok() ? "ok" : "FEHLER") << ", " << check.harvested << " Blumen geerntet, "
+        << check.leftover << " uebrig, " << check.steps << " Schritte, " << check.out_of_bounds << " ausserhalb, "
+        << check.invalid_moves << " ungueltig, " << time.human_measure() << '\n';
+}
+
+void print_tours(OutputSink& out, const Acker& acker, const Solution& solution, const RunOptions& options) {
+    {
+        ProfileScope scope("print");
+        for (const Tour& tour : solution.tours) {
+            out << tour << '\n';
+        }
+    }
+    if (options.verify)
+        print_verification(out, acker, solution);
+    if (options.harvesters > 0)
+        print_schedule(out, solution, options.harvesters);
+}
+
+void aufg_1(OutputSink& out, const std::vector<Acker>& data, bool show_files) {
+    for (const Acker& acker : data) {
+        acker.print_out(out, show_files);
+    }
+}
+
+void aufg_2(OutputSink& out, const std::vector<Acker>& data, const RunOptions& options) {
+    std::vector<Solution> solutions = solve_all(data, &Acker::simple_solution, "simple", options);
+    for (size_t i=0; i < data.size(); ++i) {
+        print_solution(out, "einfache Loesung", solutions[i]);
+        print_tours(out, data[i], solutions[i], options);
+    }
+}
+
+void aufg_3(OutputSink& out, const std::vector<Acker>& data, const RunOptions& options) {
+    std::vector<Solution> simple = solve_all(data, &Acker::simple_solution, "simple", options);
+    std::vector<Solution> better = solve_all(data, &Acker::last_flower_solution, "last_flower", options);
+    for (size_t i=0; i < data.size(); ++i) {
+        print_solution(out, "bessere Loesung", better[i]);
+        out << "Ersparnis: " << simple[i].tour_numbers - better[i].tour_numbers << " Tour(en), " << simple[i].steps - better[i].steps << " Schritte\n";
+        print_tours(out, data[i], better[i], options);
     }
 }
 
-void aufg_2(const std::vector<Acker>& data) {
-    for (Acker acker : data) {
-        int steps = 0;
+// Untergrenze: minimale Tourenzahl ohne Kapazität und ceil(Blumen / Kapazität)
+void aufg_4_capacity(OutputSink& out, const std::vector<Acker>& data, const RunOptions& options) {
+    const int capacity = options.capacity;
+    std::vector<Solution> minimal = solve_all(data, &Acker::min_tour_solution, "min_tour", options);
+    std::vector<Solution> limited = solve_all(data, [capacity](const Acker& acker, long& steps, int& tour_numbers) {
+        return acker.capacity_solution(capacity, steps, tour_numbers);
+    }, "capacity_" + std::to_string(capacity), options);
+    for (size_t i=0; i < data.size(); ++i) {
+        const long bound = std::max(long(minimal[i].tour_numbers), (data[i].get_flower_count() + capacity - 1) / capacity);
+        print_solution(out, "Loesung mit Kapazitaet " + std::to_string(capacity), limited[i]);
+        out << "Untergrenze: " << bound << " Tour(en)\n";
+        print_tours(out, data[i], limited[i], options);
+    }
+}
+
+void aufg_4(OutputSink& out, const std::vector<Acker>& data, const RunOptions& options) {
+    if (options.capacity > 0) {
+        aufg_4_capacity(out, data, options);
+        return;
+    }
+    std::vector<Solution> solutions = solve_all(data, &Acker::min_tour_solution, "min_tour", options);
+    for (size_t i=0; i < data.size(); ++i) {
+        print_solution(out, "minimale Loesung", solutions[i]);
+        print_tours(out, data[i], solutions[i], options);
+    }
+}
+
+// einfache Loesung ohne das Feld zu laden, Touren vor der Zusammenfassung
+void aufg_2_stream(OutputSink& out, const std::vector<std::string>& paths, size_t block_size) {
+    for (const std::string& path : paths) {
+        long steps = 0;
         int tour_numbers = 0;
         // time
         Timer time;
-        std::vector<std::string> tours = acker.simple_solution(steps, tour_numbers);
-        std::cout << "einfache Loesung: " << tour_numbers << " Tour(en), " << steps << " Schritte, " << time.human_measure() << std::endl;
-        for (const std::string& tour : tours) {
-            std::cout << tour << std::endl;
-        }
+        stream_simple_solution(path, [&out](const Tour& tour) { out << tour << '\n'; }, steps, tour_numbers, block_size);
+        out << "einfache Loesung (Stream): " << tour_numbers << " Tour(en), " << steps << " Schritte, " << time.human_measure() << '\n';
+    }
+}
+
+// --generate=datei --rows=.. --cols=.. --density=.. --layout=.. --seed=.. --jobs=..
+void generate(OutputSink& out, const args_t& args) {
+    FieldSpec spec;
+    spec.rows = args.int_option("rows", 100);
+    spec.columns = args.int_option("cols", 100);
+    spec.density = args.double_option("density", spec.density);
+    spec.seed = uint64_t(args.long_option("seed", long(spec.seed)));
+    if (!parse_layout(args.option("layout", "uniform"), spec.layout)) {
+        throw pbma_exception("unbekanntes Layout", args.option("layout"));
     }
+    const std::string path = args.option("generate");
+    Timer time;
+    const long flowers = write_field(spec, path, args.int_option("jobs", 0));
+    out << path << ": Zeilen=" << spec.rows << ", Spalten=" << spec.columns << ", Blumen=" << flowers
+        << ", " << layout_name(spec.layout) << ", " << time.human_measure() << '\n';
 }
 
 int main(int argc, char** argv) {
     args_t args(argc, argv);
-    std::vector<Acker> data;
+    // --out=datei, --out=null zum Messen ohne Ausgabe, sonst stdout
+    const std::string out_target = args.option("out", "-");
+    OutputSink out(out_target);
+    // Gesamtzeit, Cache-Zähler und Profil bleiben auf stdout, auch bei --out=null
+    std::unique_ptr<OutputSink> own_summary;
+    if (out_target != "-")
+        own_summary = std::make_unique<OutputSink>("-");
+    OutputSink& summary = own_summary ? *own_summary : out;
+    // -profile: Phasen messen und am Ende zusammenfassen
+    Profiler::enable(args.flag("profile"));
+    if (args.has_option("generate")) {
+        generate(out, args);
+        return 0;
+    }
+    bool flag_index = args.flag("index");
+    std::vector<std::string> paths;
     for (std::string path : args.positionals()) {
         path.insert(0, "../");
         if (file_exists(path)) {
-            std::vector<std::string> lines = read_lines(path);
-            data.emplace_back(lines, path);
+            paths.push_back(path);
         }
     }
+    if (args.flag("stream")) {
+        {
+            ProfileScope stream("stream");
+            aufg_2_stream(out, paths, size_t(args.long_option("block", 1L << 20)));
+        }
+        Profiler::report(summary);
+        return 0;
+    }
+    std::vector<Acker> data;
+    {
+        ProfileScope load("load");
+        for (const std::string& path : paths) {
+            if (is_binary_field(path)) {
+                data.push_back(load_binary_field(path, args.int_option("first-row", 0), args.int_option("row-count", -1)));
+                if (flag_index)
+                    data.back().build_index();
+            } else {
+                data.push_back(Acker::from_file(path, flag_index));
+            }
+        }
+    }
+    // Textfeld ins Binärformat wandeln: --convert=ziel.bin
+    if (args.has_option("convert")) {
+        for (const Acker& acker : data) {
+            const std::string target = data.size() == 1 ? args.option("convert") : acker.get_path() + ".bin";
+            Timer time;
+            save_binary_field(acker, target);
+            out << acker.get_path() << " -> " << target << ", " << time.human_measure() << '\n';
+        }
+        return 0;
+    }
     bool flag_z = args.flag("z");
+    int aufgabe = args.int_option("aufg", 2);
+    RunOptions options;
+    options.jobs = args.int_option("jobs", 1);
+    options.harvesters = args.int_option("harvesters", 0);
+    options.capacity = args.int_option("capacity", 0);
+    options.verify = args.flag("verify");
+    // --cache=verzeichnis --cache-size=MB
+    std::unique_ptr<SolutionCache> cache;
+    if (args.has_option("cache")) {
+        cache = std::make_unique<SolutionCache>(args.option("cache"), uint64_t(args.long_option("cache-size", 256)) << 20);
+        options.cache = cache.get();
+    }
 
-//    aufg_1(data, flag_z);
-    aufg_2(data);
+    Timer total;
+//    aufg_1(out, data, flag_z);
+    if (aufgabe == 3) {
+        aufg_3(out, data, options);
+    } else if (aufgabe == 4) {
+        aufg_4(out, data, options);
+    } else {
+        aufg_2(out, data, options);
+    }
+    if (args.has_option("jobs")) {
+        summary << "Gesamt: " << data.size() << " Feld(er), " << options.jobs << " Thread(s), " << total.human_measure() << '\n';
+    }
+    if (cache) {
+        summary << "Cache: " << cache->get_hits() << " Treffer, " << cache->get_misses() << " Fehlschlaege, "
+            << cache->get_stores() << " gespeichert, " << cache->get_evictions() << " verdraengt\n";
+    }
+    Profiler::report(summary);
 }
-
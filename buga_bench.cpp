@@ -0,0 +1,296 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+// Benchmark-Suite: Phasen Laden, Zählen und Lösen über die acker/*.dat-Dateien
+// und über synthetische Felder, jede Phase mehrfach, Median und p95,
+// Ergebnisse zusätzlich als CSV zum Vergleich zwischen Versionen.
+//
+// Optionen: --dir=../acker --sizes=1000,4000 --density=0.05 --repeat=5
+//           --layout=uniform --seed=1 --max-text=100000000 --csv=bench.csv
+//           --planners=simple,last_flower,min_tour,incremental
+//           (incremental: --updates=256 zufällige set_flower, IncrementalPlanner
+//           gegen erneutes simple_solution nach jeder Änderung)
+//           (ohne --planners entfällt last_flower ab 10^8 Zellen: Aufwand
+//           O(Touren * Zeilen), bei 100000x100000 Stunden je Wiederholung)
+//           --numbers=zahlen.txt --max-jobs=N: read_ints/read_doubles_parallel
+//           mit 1, 2, 4, ... N Threads
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pbma.h"
+#include "Acker.h"
+#include "FieldGenerator.h"
+#include "IncrementalPlanner.h"
+
+struct PhaseResult {
+    std::string field;
+    int rows;
+    int columns;
+    long flowers;
+    std::string phase;
+    std::vector<long> samples_ns;
+};
+
+static PhaseResult run_phase(const std::string& phase, const Acker& acker, int repeats,
+                             const std::function<void()>& body) {
+    PhaseResult result{acker.get_path(), acker.get_rows(), acker.get_columns(),
+                       acker.get_flower_count(), phase, {}};
+    for (int r=0; r < repeats; ++r) {
+        Timer time;
+        body();
+        result.samples_ns.push_back(time.measure_net_ns());
+    }
+    return result;
+}
+
+// flowers_per_row je Zeile einzeln, Phasen unter einer Mikrosekunde,
+// daher abzüglich der kalibrierten Timer-Kosten
+static PhaseResult bench_row_count(const Acker& acker, const std::vector<std::string>& rows) {
+    PhaseResult result{acker.get_path(), acker.get_rows(), acker.get_columns(),
+                       acker.get_flower_count(), "flowers_per_row", {}};
+    for (const std::string& row : rows) {
+        Timer time;
+        volatile int flowers = Acker::flowers_per_row(row);
+        result.samples_ns.push_back(time.measure_net_ns());
+        (void) flowers;
+    }
+    return result;
+}
+
+static void bench_planner(std::vector<PhaseResult>& results, const std::string& name, const Acker& acker,
+                          int repeats, const std::function<std::vector<Tour>(const Acker&, long&, int&)>& planner) {
+    results.push_back(run_phase("solve_" + name, acker, repeats, [&]() {
+        long steps = 0;
+        int tour_numbers = 0;
+        planner(acker, steps, tour_numbers);
+    }));
+}
+
+static std::vector<std::string> split_list(const std::string& list) {
+    std::vector<std::string> items;
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+static std::vector<std::string> planners;
+static bool planners_given = false; // --planners gesetzt, keine Größengrenze
+static const long LAST_FLOWER_MAX_CELLS = 100000000;
+
+static bool planner_selected(const std::string& name) {
+    return std::find(planners.begin(), planners.end(), name) != planners.end();
+}
+
+static int updates = 256;
+
+struct Update {
+    int row;
+    int col;
+    bool flower;
+};
+
+// update_incremental: IncrementalPlanner::set_flower je Änderung,
+// update_resolve: Acker::set_flower und danach simple_solution komplett neu.
+// Beide Phasen messen dieselben Änderungen, der Aufbau liegt außerhalb.
+static void bench_updates(std::vector<PhaseResult>& results, const Acker& acker, int repeats) {
+    if (acker.get_rows() == 0 || acker.get_columns() == 0 || updates <= 0)
+        return;
+    std::mt19937 rng(1);
+    std::vector<Update> changes;
+    for (int u=0; u < updates; ++u) {
+        const int row = int(rng() % unsigned(acker.get_rows()));
+        const int col = int(rng() % unsigned(acker.get_columns()));
+        changes.push_back({row, col, rng() % 2 == 0});
+    }
+    PhaseResult incremental{acker.get_path(), acker.get_rows(), acker.get_columns(),
+                            acker.get_flower_count(), "update_incremental", {}};
+    PhaseResult resolve = incremental;
+    resolve.phase = "update_resolve";
+    long incremental_steps = 0;
+    long resolve_steps = 0;
+    for (int r=0; r < repeats; ++r) {
+        IncrementalPlanner planner(acker);
+        Timer time;
+        for (const Update& change : changes) {
+            planner.set_flower(change.row, change.col, change.flower);
+        }
+        incremental.samples_ns.push_back(time.measure_net_ns());
+        incremental_steps = planner.get_steps();
+
+        Acker copy = acker;
+        Timer resolve_time;
+        for (const Update& change : changes) {
+            copy.set_flower(change.row, change.col, change.flower);
+            long steps = 0;
+            int tour_numbers = 0;
+            copy.simple_solution(steps, tour_numbers);
+            resolve_steps = steps;
+        }
+        resolve.samples_ns.push_back(resolve_time.measure_net_ns());
+    }
+    if (incremental_steps != resolve_steps) {
+        throw pbma_exception("buga_bench: IncrementalPlanner weicht ab", acker.get_path());
+    }
+    results.push_back(std::move(incremental));
+    results.push_back(std::move(resolve));
+}
+
+static void bench_field(std::vector<PhaseResult>& results, const Acker& acker, int repeats) {
+    results.push_back(run_phase("count", acker, repeats, [&]() {
+        volatile uint64_t flowers = acker.count_flowers(0, 0, acker.get_rows(), acker.get_columns());
+        (void) flowers;
+    }));
+    if (planner_selected("simple"))
+        bench_planner(results, "simple", acker, repeats, &Acker::simple_solution);
+    if (planner_selected("last_flower")) {
+        if (planners_given || long(acker.get_rows()) * acker.get_columns() <= LAST_FLOWER_MAX_CELLS)
+            bench_planner(results, "last_flower", acker, repeats, &Acker::last_flower_solution);
+        else
+            std::cout << acker.get_path() << " solve_last_flower: uebersprungen, zu gross (--planners=last_flower erzwingt)" << std::endl;
+    }
+    if (planner_selected("incremental"))
+        bench_updates(results, acker, repeats);
+    if (planner_selected("min_tour"))
+        bench_planner(results, "min_tour", acker, repeats, &Acker::min_tour_solution);
+}
+
+// Textform eines Feldes wie in den .dat-Dateien
+static std::string field_text(const Acker& acker) {
+    std::string text;
+    text.reserve(size_t(acker.get_rows()) * (size_t(acker.get_columns()) + 1));
+    for (int i=0; i < acker.get_rows(); ++i) {
+        for (int j=0; j < acker.get_columns(); ++j) {
+            text += acker.has_flower(i, j) ? '*' : ' ';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+// Skalierung des parallelen Einlesens, Phasen read_ints_jN und read_doubles_jN
+static void bench_numbers(std::vector<PhaseResult>& results, const std::string& path, int max_jobs, int repeats) {
+    std::vector<int> jobs_list;
+    for (int jobs=1; jobs < max_jobs; jobs *= 2) {
+        jobs_list.push_back(jobs);
+    }
+    jobs_list.push_back(max_jobs);
+    const long bytes = long(std::filesystem::file_size(path));
+    for (const char* kind : {"read_ints", "read_doubles"}) {
+        const bool ints = std::string(kind) == "read_ints";
+        long base = 0;
+        for (int jobs : jobs_list) {
+            PhaseResult result{path, 0, 0, 0, std::string(kind) + "_j" + std::to_string(jobs), {}};
+            for (int r=0; r < repeats; ++r) {
+                Timer time;
+                result.flowers = long(ints ? read_ints_parallel(path, jobs).size() : read_doubles_parallel(path, jobs).size());
+                result.samples_ns.push_back(time.measure_net_ns());
+            }
+            const long median = percentile(result.samples_ns, 0.5);
+            if (jobs == 1)
+                base = median;
+            std::cout << path << " " << result.phase << ": " << format(long(double(bytes) / 1e6 / (double(median) / 1e9)), 5)
+                      << " MB/s, Speedup " << std::fixed << std::setprecision(2) << double(base) / double(median) << std::endl;
+            results.push_back(std::move(result));
+        }
+    }
+}
+
+static std::vector<int> parse_sizes(const std::string& list) {
+    std::vector<int> sizes;
+    for (const std::string& item : split_list(list)) {
+        sizes.push_back(std::stoi(item));
+    }
+    return sizes;
+}
+
+int main(int argc, char** argv) {
+    args_t args(argc, argv);
+    const std::string dir = args.option("dir", "../acker");
+    const std::vector<int> sizes = parse_sizes(args.option("sizes", "1000,4000"));
+    const int repeats = std::max(1, args.int_option("repeat", 5));
+    FieldSpec spec;
+    spec.density = args.double_option("density", spec.density);
+    spec.seed = uint64_t(args.long_option("seed", long(spec.seed)));
+    if (!parse_layout(args.option("layout", "uniform"), spec.layout)) {
+        throw pbma_exception("buga_bench: unbekanntes Layout", args.option("layout"));
+    }
+    const long max_text = args.long_option("max-text", 100000000);
+    planners_given = args.has_option("planners");
+    planners = split_list(args.option("planners", "simple,last_flower,min_tour,incremental"));
+    updates = args.int_option("updates", updates);
+
+    std::vector<PhaseResult> results;
+    std::cout << "Timer: " << Timer::overhead_ns() << "ns je Messung, wird abgezogen" << std::endl;
+
+    std::vector<std::string> files;
+    if (std::filesystem::is_directory(dir)) {
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            if (entry.path().extension() == ".dat")
+                files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (const std::string& path : files) {
+        Acker acker = Acker::from_file(path);
+        results.push_back(run_phase("load", acker, repeats, [&]() {
+            Acker loaded = Acker::from_file(path);
+        }));
+        const std::vector<std::string> rows = read_lines(path);
+        if (!rows.empty())
+            results.push_back(bench_row_count(acker, rows));
+        bench_field(results, acker, repeats);
+    }
+
+    if (args.has_option("numbers")) {
+        const int max_jobs = args.int_option("max-jobs", int(std::max(1u, std::thread::hardware_concurrency())));
+        bench_numbers(results, args.option("numbers"), std::max(1, max_jobs), repeats);
+    }
+
+    for (int size : sizes) {
+        spec.rows = size;
+        spec.columns = size;
+        Acker acker = generate_field(spec);
+        if (long(size) * size <= max_text) {
+            const std::string text = field_text(acker);
+            results.push_back(run_phase("load", acker, repeats, [&]() {
+                Acker loaded(text, acker.get_path());
+            }));
+        }
+        bench_field(results, acker, repeats);
+    }
+
+    for (const PhaseResult& result : results) {
+        std::cout << result.field << " " << result.phase << ": median="
+                  << Timer::human_format(double(percentile(result.samples_ns, 0.5)) / 1e9)
+                  << ", p95=" << Timer::human_format(double(percentile(result.samples_ns, 0.95)) / 1e9)
+                  << std::endl;
+    }
+
+    if (args.has_option("csv")) {
+        std::ofstream csv(args.option("csv"));
+        if (!csv) {
+            throw pbma_exception("buga_bench: csv nicht schreibbar", args.option("csv"));
+        }
+        csv << "field,rows,columns,flowers,phase,repeats,median_ns,p95_ns,min_ns\n";
+        for (const PhaseResult& result : results) {
+            csv << result.field << ',' << result.rows << ',' << result.columns << ',' << result.flowers << ','
+                << result.phase << ',' << result.samples_ns.size() << ','
+                << percentile(result.samples_ns, 0.5) << ',' << percentile(result.samples_ns, 0.95) << ','
+                << *std::min_element(result.samples_ns.begin(), result.samples_ns.end()) << '\n';
+        }
+    }
+}
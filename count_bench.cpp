@@ -0,0 +1,57 @@
+//
+// Created by Maximilian Wernz on 16.10.26.
+//
+
+// Mikrobenchmark für das Zählwerk: Bytes pro Sekunde je Variante
+// bei 512 und 64k Zeichen breiten Zeilen.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "pbma.h"
+#include "Bits.h"
+#include "FlowerCount.h"
+
+static void bench_width(size_t width, size_t total_bytes, int repeats) {
+    const size_t rows = std::max(total_bytes / width, size_t(1));
+    std::string field(rows * width, ' ');
+    std::mt19937 gen(4711);
+    std::bernoulli_distribution is_flower(0.1);
+    for (char& ch : field) {
+        if (is_flower(gen))
+            ch = '*';
+    }
+    std::vector<uint64_t> bits(words_for(int(width)));
+
+    for (CountEngine engine : {CountEngine::scalar, CountEngine::sse2, CountEngine::avx2}) {
+        if (!engine_supported(engine))
+            continue;
+        double best = 0;
+        size_t flowers = 0;
+        for (int r=0; r < repeats; ++r) {
+            flowers = 0;
+            Timer time;
+            for (size_t i=0; i < rows; ++i) {
+                flowers += pack_flowers(field.data() + i * width, width, bits.data(), engine);
+            }
+            const double secs = time.measure();
+            const double rate = double(field.size()) / secs;
+            if (rate > best)
+                best = rate;
+        }
+        std::cout << "Breite=" << format(long(width), 6) << " " << format(long(rows), 7) << " Zeilen "
+                  << engine_name(engine) << (engine == best_count_engine() ? "*" : " ") << ": "
+                  << format(long(best / 1e6), 6) << " MB/s, Blumen=" << flowers << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    args_t args(argc, argv);
+    const long megabytes = args.long_option("mb", 64);
+    const int repeats = args.int_option("repeat", 5);
+    for (size_t width : {size_t(512), size_t(65536)}) {
+        bench_width(width, size_t(megabytes) << 20, repeats);
+    }
+}
@@ -1,9 +1,14 @@
 #include "pbma.h"
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cerrno>
 #include <climits>
+#include <cstring>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <memory>
@@ -11,12 +16,18 @@
 #include <sstream>
 #include <thread>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define PBMA_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // @PBMA: Das müssen Sie alles nicht lesen oder verstehen, nur verwenden.
 
 using namespace std;
 
-static constexpr long MAX_FILESIZE = 1073741824; // one GByte, for binary
-
 pbma_exception::pbma_exception(const std::string& _cause) {
     this->cause = "pbma exception:: " + _cause;
 }
@@ -107,9 +118,9 @@ vector<char> read_bytes(const std::string& filename) {
     const streamsize length = is.tellg(); // length/size of file
     // go to start of file
     is.seekg(0, is.beg);
-    if (length > MAX_FILESIZE || length < 0) {
+    if (length < 0) {
         const char* s = filename.c_str();
-        throw error(format("read_bytes: filename=%s zu gross", s));
+        throw error(format("read_bytes: filename=%s Einlesefehler", s));
     }
     vector<char> buffer(static_cast<size_t>(length));
     is.read(buffer.data(), length); // read completely
@@ -121,25 +132,177 @@ vector<char> read_bytes(const std::string& filename) {
     return buffer; // should not be copied, move semantics
 }
 
-static const char COMMENT_PREFIX[] = "#";
-vector<string> read_lines(const std::string& filename) {
-    ifstream is(filename);
-    if (!is) {
+#ifdef PBMA_HAVE_MMAP
+// liest fd bis EOF, für Dateien ohne bekannte Größe
+static bool read_all(int fd, vector<char>& buffer) {
+    size_t used = 0;
+    buffer.resize(64 * 1024);
+    for (;;) {
+        if (used == buffer.size()) {
+            buffer.resize(2 * buffer.size());
+        }
+        const ssize_t got = read(fd, buffer.data() + used, buffer.size() - used);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got < 0) {
+            return false;
+        }
+        if (got == 0) {
+            break;
+        }
+        used += static_cast<size_t>(got);
+    }
+    buffer.resize(used);
+    buffer.shrink_to_fit();
+    return true;
+}
+#endif
+
+MappedFile::MappedFile(const std::string& filename, Advice advice) {
+#ifdef PBMA_HAVE_MMAP
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
         const char* s = filename.c_str();
-        throw error(format("read_lines: filename=%s nicht lesbar", s));
+        throw error(format("MappedFile: filename=%s nicht lesbar", s));
     }
-    vector<string> lines;
-    string line;
-    while (getline(is, line)) {
-        if (line.empty()) {
-            continue;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        const char* s = filename.c_str();
+        throw error(format("MappedFile: filename=%s Einlesefehler", s));
+    }
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+        // Pipes, /dev/stdin, /proc: Größe unbekannt, daher lesen statt einblenden
+        const bool ok = read_all(fd, _buffer);
+        close(fd);
+        if (!ok) {
+            const char* s = filename.c_str();
+            throw error(format("MappedFile: filename=%s Einlesefehler", s));
         }
-        if (starts_with(line, COMMENT_PREFIX)) {
-            continue;
+        _data = _buffer.empty() ? nullptr : _buffer.data();
+        _size = _buffer.size();
+        return;
+    }
+    _size = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        const char* s = filename.c_str();
+        throw error(format("MappedFile: filename=%s mmap fehlgeschlagen", s));
+    }
+    _data = static_cast<const char*>(addr);
+    _mapped = true;
+    close(fd); // mapping stays valid
+    if (advice != Advice::normal) {
+        this->advise(advice);
+    }
+#else
+    (void) advice;
+    _buffer = read_bytes(filename);
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+}
+
+void MappedFile::advise(Advice advice, size_t offset, size_t length) const noexcept {
+#ifdef PBMA_HAVE_MMAP
+    if (!_mapped || offset >= _size) {
+        return;
+    }
+    length = min(length, _size - offset);
+    // madvise verlangt einen seitenausgerichteten Anfang
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(_data + offset);
+    const uintptr_t aligned = begin - begin % page;
+    int flag = MADV_NORMAL;
+    switch (advice) {
+    case Advice::sequential:
+        flag = MADV_SEQUENTIAL;
+        break;
+    case Advice::random:
+        flag = MADV_RANDOM;
+        break;
+    case Advice::willneed:
+        flag = MADV_WILLNEED;
+        break;
+    default:
+        break;
+    }
+    madvise(reinterpret_cast<void*>(aligned), length + (begin - aligned), flag);
+#else
+    (void) advice;
+    (void) offset;
+    (void) length;
+#endif
+}
+
+void MappedFile::unmap() noexcept {
+#ifdef PBMA_HAVE_MMAP
+    if (_mapped) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+    _buffer.clear();
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(other._data), _size(other._size), _buffer(std::move(other._buffer)),
+      _mapped(other._mapped) {
+    other._data = nullptr;
+    other._size = 0;
+    other._mapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        _data = other._data;
+        _size = other._size;
+        _buffer = std::move(other._buffer);
+        _mapped = other._mapped;
+        other._data = nullptr;
+        other._size = 0;
+        other._mapped = false;
+    }
+    return *this;
+}
+
+static const char COMMENT_PREFIX[] = "#";
+void split_lines(std::string_view text, std::vector<std::string_view>& lines) {
+    while (!text.empty()) {
+        const char* end = static_cast<const char*>(memchr(text.data(), '\n', text.size()));
+        const size_t length = end ? static_cast<size_t>(end - text.data()) : text.size();
+        if (length > 0 && text[0] != COMMENT_PREFIX[0]) {
+            lines.push_back(text.substr(0, length));
         }
-        lines.push_back(line);
+        text.remove_prefix(end ? length + 1 : length);
     }
-    return lines;
+}
+
+LineBuffer::LineBuffer(const std::string& filename)
+    : LineBuffer(MappedFile(filename, MappedFile::Advice::sequential)) {}
+
+LineBuffer::LineBuffer(MappedFile file) : _file(std::move(file)) {
+    split_lines(_file.view(), _lines);
+}
+
+vector<string> read_lines(const std::string& filename) {
+    const LineBuffer buffer(filename);
+    return vector<string>(buffer.begin(), buffer.end());
+}
+
+vector<string> read_lines(const MappedFile& file) {
+    vector<string_view> lines;
+    split_lines(file.view(), lines);
+    return vector<string>(lines.begin(), lines.end());
 }
 
 // unfortunately, regular expressions let compile time explode
@@ -151,25 +314,25 @@ static const char CHARS_GERMAN_WORDS[] = "abcdefghijklmnopqrstuvwxyz"
 static const char CHARS_INTEGRAL_WORDS[] = "-+0123456789";
 
 // private, words as changeable parameter, for reuse
-static void read_accept_str_vec(const string& line, const string& accept,
+static void read_accept_str_vec(string_view line, const string& accept,
                                 vector<string>& words) {
     size_t prev = 0, pos;
     while ((pos = line.find_first_of(CHARS_DELIM, prev)) != string::npos) {
         if (pos > prev) {
-            string word = line.substr(prev, pos - prev);
+            string_view word = line.substr(prev, pos - prev);
             if (word.size() > 0 && // nonempty, only of acceptable chars
                 word.find_first_not_of(accept) == string::npos) {
-                words.push_back(word);
+                words.emplace_back(word);
             }
         }
         prev = pos + 1;
     }
     // something remaining, do not forget last match
-    string word = line.substr(prev);
+    string_view word = line.substr(prev);
     // double that code of the if in the loop
     if (word.size() > 0 && // nonempty, only of acceptable chars
         word.find_first_not_of(accept) == string::npos) {
-        words.push_back(word);
+        words.emplace_back(word);
     }
 }
 
@@ -193,53 +356,225 @@ vector<string> read_words(const std::string& filename) {
     return read_accept_file(filename, CHARS_GERMAN_WORDS);
 }
 
-vector<int> read_ints(const std::string& filename) {
-    vector<int> ints;
-    for (const string& iword :
-             read_accept_file(filename, CHARS_INTEGRAL_WORDS)) {
-        try {
-            const int val = stoi(iword);
-            ints.push_back(val);
-        } catch (const invalid_argument& err) {
-            auto s = iword.c_str();
-            throw error(format("read_ints: kein int %s, %s", s, err.what()));
+// Zeichenklassen für das Parsen am Stück, eine Tabelle je Menge erlaubter Zeichen
+enum CharClass : unsigned char { CHAR_OTHER, CHAR_ACCEPT, CHAR_DELIM, CHAR_NEWLINE };
+
+struct CharClasses {
+    unsigned char table[256];
+    explicit CharClasses(const char* accept) {
+        memset(table, CHAR_OTHER, sizeof(table));
+        for (const char* c = accept; *c; ++c) {
+            table[static_cast<unsigned char>(*c)] = CHAR_ACCEPT;
+        }
+        for (const char* c = CHARS_DELIM; *c; ++c) {
+            table[static_cast<unsigned char>(*c)] = CHAR_DELIM;
+        }
+        table[static_cast<unsigned char>('\n')] = CHAR_NEWLINE;
+    }
+    unsigned char operator()(char c) const { return table[static_cast<unsigned char>(c)]; }
+};
+
+static const CharClasses INTEGRAL_CLASSES(CHARS_INTEGRAL_WORDS);
+
+// ein Wort wie stoi/stol: optionales '+' oder '-', dann Ziffern, Rest ignoriert
+template <typename T>
+static T parse_integral(const char* first, const char* last, const char* who, const char* type, const char* what) {
+    const char* p = first;
+    if (p < last && *p == '+' && p + 1 < last && p[1] != '-')
+        ++p;
+    T val = 0;
+    const from_chars_result result = from_chars(p, last, val);
+    if (result.ec == errc::result_out_of_range) {
+        throw out_of_range(what);
+    }
+    if (result.ec != errc()) {
+        const string word(first, last);
+        throw error(format("%s: kein %s %s, %s", who, type, word.c_str(), what));
+    }
+    return val;
+}
+
+// ein Durchlauf über den Text: Zeilen wie read_lines (leer oder '#' am
+// Anfang: übersprungen), Wörter wie read_accept_str_vec, nur Wörter aus
+// erlaubten Zeichen werden mit convert gewandelt, ohne Zwischenstring je Wort
+template <typename T, typename Convert>
+static void parse_words(string_view text, const CharClasses& classes, vector<T>& values, Convert convert) {
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    while (p < end) {
+        if (*p == COMMENT_PREFIX[0]) {
+            p = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (p == nullptr)
+                break;
+            ++p;
+            continue;
+        }
+        while (p < end) {
+            const unsigned char c = classes(*p);
+            if (c == CHAR_NEWLINE) {
+                ++p;
+                break;
+            }
+            if (c == CHAR_DELIM) {
+                ++p;
+                continue;
+            }
+            // CHAR_OTHER ist 0, CHAR_ACCEPT 1: ein Wort zählt nur, wenn alle 1 sind
+            const char* word = p;
+            unsigned char accepted = CHAR_ACCEPT;
+            for (unsigned char k; p < end && (k = classes(*p)) < CHAR_DELIM; ++p) {
+                accepted &= k;
+            }
+            if (accepted)
+                values.push_back(convert(word, p));
         }
     }
-    return ints;
 }
 
-vector<long> read_longs(const std::string& filename) {
-    vector<long> longs;
-    for (const string& lword :
-             read_accept_file(filename, CHARS_INTEGRAL_WORDS)) {
+// wie parse_words, aber in jobs Stücken, die jeweils hinter einem '\n'
+// beginnen, damit Kommentarzeilen und Wörter nicht zerschnitten werden.
+// Ergebnisse in Reihenfolge der Stücke; bei Fehlern gewinnt das erste
+// Stück, also derselbe Fehler wie seriell.
+template <typename T, typename Convert>
+static vector<T> parse_words_parallel(string_view text, const CharClasses& classes, int jobs, Convert convert) {
+    static constexpr size_t MIN_CHUNK = size_t(1) << 20;
+    if (jobs <= 0)
+        jobs = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    jobs = static_cast<int>(min(static_cast<size_t>(jobs), max(size_t(1), text.size() / MIN_CHUNK)));
+    vector<T> values;
+    if (jobs == 1) {
+        parse_words(text, classes, values, convert);
+        return values;
+    }
+    vector<size_t> bounds{0};
+    for (int j=1; j < jobs; ++j) {
+        const size_t pos = max(bounds.back(), text.size() / static_cast<size_t>(jobs) * static_cast<size_t>(j));
+        const void* newline = memchr(text.data() + pos, '\n', text.size() - pos);
+        bounds.push_back(newline ? static_cast<size_t>(static_cast<const char*>(newline) - text.data()) + 1 : text.size());
+    }
+    bounds.push_back(text.size());
+
+    vector<vector<T>> parts(static_cast<size_t>(jobs));
+    vector<exception_ptr> errors(static_cast<size_t>(jobs));
+    auto worker = [&](size_t j) {
         try {
-            const long val = stol(lword);
-            longs.push_back(val);
-        } catch (const invalid_argument& err) {
-            auto s = lword.c_str();
-            throw error(format("read_longs: kein long %s, %s", s, err.what()));
+            parse_words(text.substr(bounds[j], bounds[j + 1] - bounds[j]), classes, parts[j], convert);
+        } catch (...) {
+            errors[j] = current_exception();
         }
+    };
+    vector<thread> pool;
+    for (size_t j=1; j < parts.size(); ++j) {
+        pool.emplace_back(worker, j);
+    }
+    worker(0);
+    for (thread& t : pool) {
+        t.join();
+    }
+    size_t total = 0;
+    for (size_t j=0; j < parts.size(); ++j) {
+        if (errors[j])
+            rethrow_exception(errors[j]);
+        total += parts[j].size();
     }
+    values.reserve(total);
+    for (const vector<T>& part : parts) {
+        values.insert(values.end(), part.begin(), part.end());
+    }
+    return values;
+}
+
+static int convert_int(const char* first, const char* last) {
+    return parse_integral<int>(first, last, "read_ints", "int", "stoi");
+}
+
+static long convert_long(const char* first, const char* last) {
+    return parse_integral<long>(first, last, "read_longs", "long", "stol");
+}
+
+vector<int> read_ints(const MappedFile& file) {
+    vector<int> ints;
+    parse_words(file.view(), INTEGRAL_CLASSES, ints, convert_int);
+    return ints;
+}
+
+vector<int> read_ints(const std::string& filename) {
+    return read_ints(MappedFile(filename, MappedFile::Advice::sequential));
+}
+
+vector<long> read_longs(const MappedFile& file) {
+    vector<long> longs;
+    parse_words(file.view(), INTEGRAL_CLASSES, longs, convert_long);
     return longs;
 }
 
+vector<long> read_longs(const std::string& filename) {
+    return read_longs(MappedFile(filename, MappedFile::Advice::sequential));
+}
+
+vector<int> read_ints_parallel(const MappedFile& file, int jobs) {
+    return parse_words_parallel<int>(file.view(), INTEGRAL_CLASSES, jobs, convert_int);
+}
+
+vector<int> read_ints_parallel(const std::string& filename, int jobs) {
+    return read_ints_parallel(MappedFile(filename, MappedFile::Advice::willneed), jobs);
+}
+
+vector<long> read_longs_parallel(const MappedFile& file, int jobs) {
+    return parse_words_parallel<long>(file.view(), INTEGRAL_CLASSES, jobs, convert_long);
+}
+
+vector<long> read_longs_parallel(const std::string& filename, int jobs) {
+    return read_longs_parallel(MappedFile(filename, MappedFile::Advice::willneed), jobs);
+}
+
 static const char CHARS_FLOAT_WORDS[] = "-+0123456789.";
-vector<double> read_doubles(const std::string& filename) {
-    vector<double> doubles;
-    for (const string& dword :
-             read_accept_file(filename, CHARS_FLOAT_WORDS)) {
-        try {
-            const double val = stod(dword);
-            doubles.push_back(val);
-        } catch (const invalid_argument& err) {
-            auto s = dword.c_str();
-            auto e = err.what();
-            throw error(format("read_doubles: kein double %s, %s", s, e));
-        }
+static const CharClasses FLOAT_CLASSES(CHARS_FLOAT_WORDS);
+
+// ein Wort wie stod: strtod auf einer nullterminierten Kopie, kurze Wörter
+// auf dem Stack
+static double convert_double(const char* first, const char* last) {
+    const size_t length = static_cast<size_t>(last - first);
+    char small[64];
+    string large;
+    const char* word = small;
+    if (length < sizeof(small)) {
+        memcpy(small, first, length);
+        small[length] = '\0';
+    } else {
+        large.assign(first, last);
+        word = large.c_str();
+    }
+    char* stop = nullptr;
+    errno = 0;
+    const double val = strtod(word, &stop);
+    if (stop == word) {
+        throw error(format("read_doubles: kein double %s, %s", word, "stod"));
+    }
+    if (errno == ERANGE) {
+        throw out_of_range("stod");
     }
+    return val;
+}
+
+vector<double> read_doubles(const MappedFile& file) {
+    vector<double> doubles;
+    parse_words(file.view(), FLOAT_CLASSES, doubles, convert_double);
     return doubles;
 }
 
+vector<double> read_doubles(const std::string& filename) {
+    return read_doubles(MappedFile(filename, MappedFile::Advice::sequential));
+}
+
+vector<double> read_doubles_parallel(const MappedFile& file, int jobs) {
+    return parse_words_parallel<double>(file.view(), FLOAT_CLASSES, jobs, convert_double);
+}
+
+vector<double> read_doubles_parallel(const std::string& filename, int jobs) {
+    return read_doubles_parallel(MappedFile(filename, MappedFile::Advice::willneed), jobs);
+}
+
 vector<vector<int>> read_2ints(const std::string& filename) {
     vector<vector<int>> intss;
     for (const string& line : read_lines(filename)) {
@@ -292,136 +627,134 @@ static bool str2int(const string& word, int& val) {
     return true;
 }
 
+// Cursor im Fehlerzustand
+static constexpr size_t NO_POS = string_view::npos;
+
+static bool is_space(char c) {
+    return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
 // eat whitespace and all following comment lines
-static int skip_comments(const vector<char>& raw, int cur) {
-    const int size = static_cast<int>(raw.size()); // int is sufficient
-    if (cur < 0 || cur >= size) {
-        return cur;
-    }
-    while (cur < size && isspace(raw[static_cast<size_t>(cur)])) {
-        cur += 1;
-    }
-    if (cur >= size) {
-        return cur;
-    }
-    if (cur > 0) {
-        // cur - 1 is >= 0
-        if (raw[static_cast<size_t>(cur - 1)] != '\n') { // must be a new line
+static size_t skip_comments(string_view raw, size_t cur) {
+    const size_t size = raw.size();
+    while (cur < size) {
+        while (cur < size && is_space(raw[cur])) {
+            cur += 1;
+        }
+        if (cur >= size) {
             return cur;
         }
-    }
-    if (raw[static_cast<size_t>(cur)] == '#') { // comment start in new line
-        while (cur < size && raw[static_cast<size_t>(cur)] != '\n') {
+        if (cur > 0 && raw[cur - 1] != '\n') { // must be a new line
+            return cur;
+        }
+        if (raw[cur] != '#') {
+            return cur;
+        }
+        // comment start in new line, run until end of line
+        while (cur < size && raw[cur] != '\n') {
             cur += 1;
-        } // run until end of line
+        }
         if (cur < size) {
             cur += 1; // skip newline
         }
-        return skip_comments(raw, cur); // again
     }
     return cur;
 }
 
 // reads a number in a char array and positions cur after the last digit
 // returns cur, modifies parameter val
-static int read_asciiint(const vector<char>& raw, int cur, int& val) {
+static size_t read_asciiint(string_view raw, size_t cur, int& val) {
     val = 0;
-    if (cur < 0) { // already in error state
+    if (cur == NO_POS) { // already in error state
         return cur;
     }
     cur = skip_comments(raw, cur);
-    const int size = static_cast<int>(raw.size()); // int is sufficient
-    while (cur < size && isspace(raw[static_cast<size_t>(cur)])) {
+    const size_t size = raw.size();
+    while (cur < size && is_space(raw[cur])) {
         cur += 1;
     }
-    if (cur == size) {
-        return -1;
+    if (cur >= size) {
+        return NO_POS;
     }
     bool valid = false;
-    while (cur < size && isdigit(raw[static_cast<size_t>(cur)])) {
+    while (cur < size && isdigit(static_cast<unsigned char>(raw[cur]))) {
         valid = true;
         val *= 10;
         // digit to value, guaranteed by the standard
-        val += raw[static_cast<size_t>(cur)] - '0'; 
+        val += raw[cur] - '0';
         cur += 1;
     }
-    return valid ? cur : -1;
+    return valid ? cur : NO_POS;
 }
 
 // binary pgm, P5
-static std::vector<int> read_pgm5(const string& filename) {
-    vector<char> raw = read_bytes(filename); // binary format
-    if (raw[0] != 'P' || raw[1] != '5') {
+static std::vector<int> read_pgm5(const MappedFile& file, const string& filename) {
+    const string_view raw = file.view(); // binary format
+    if (raw.size() < 2 || raw[0] != 'P' || raw[1] != '5') {
         throw error("read_pgm::kein P5???");
     }
-    int cur = 2; // we are here
+    size_t cur = 2; // we are here
     int width, height, maxbright;
     cur = read_asciiint(raw, cur, width);
     cur = read_asciiint(raw, cur, height);
     cur = read_asciiint(raw, cur, maxbright);
-    if (cur == -1) {
+    if (cur == NO_POS) {
         auto s = filename.c_str();
         auto e = "keine Breite/Hoehe/Helligkeit";
         throw error(format("read_pgm5:: filename=%s, %s", s, e));
     }
     // a single whitespace, often '\n'
     // can be windows? thus two chars?
-    if (raw[static_cast<size_t>(cur)] == '\r') { 
+    if (cur < raw.size() && raw[cur] == '\r') {
         cur += 1;
-        if (cur == -1) {
-            throw error(format("read_pgm5:: filename=%s, Windows and end?",
-                               filename.c_str()));
-        }
     }
-    if (!isspace(raw[static_cast<size_t>(cur)])) {
+    if (cur >= raw.size() || !is_space(raw[cur])) {
         throw error(format("read_pgm5:: filename=%s, kein Weissraum nach spec",
                            filename.c_str()));
     }
     cur += 1;
     // ab hier binary
     const bool twobyte = maxbright >= 256;
-    const size_t offset = static_cast<size_t>(cur);
+    const size_t offset = cur;
     const size_t len_bytes = raw.size() - offset;
-    const size_t needed = static_cast<size_t>((twobyte ? 2 : 1) * width * height);
+    const size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    const size_t needed = (twobyte ? 2 : 1) * pixels;
     if (len_bytes != needed) {
         string fmt = "filename=%s, width=%d, height=%d, maxbright=%d,\n";
         fmt = "read_pgm5:: " + fmt;
-        fmt += "           len_bytes=%d, needed=%d";
+        fmt += "           len_bytes=%zu, needed=%zu";
         auto s = filename.c_str();
         throw error(format(fmt, s, width, height, maxbright, len_bytes,
                            needed));
     }
-    vector<int> img(needed + 3);
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(raw.data() + offset);
+    vector<int> img(pixels + 3);
     img[0] = width;
     img[1] = height;
     img[2] = maxbright;
     if (twobyte) {
-        for (size_t i = 0; i < needed; i += 1) {
-            char high_ch = raw[offset + 2 * i];
-            img[i + 3] = reinterpret_cast<unsigned char&>(high_ch) * 256;
-            char low_ch = raw[offset + 2 * i + 1];
-            img[i + 3] += reinterpret_cast<unsigned char&>(low_ch);
+        for (size_t i = 0; i < pixels; i += 1) {
+            img[i + 3] = bytes[2 * i] * 256 + bytes[2 * i + 1];
         }
     } else {
-        for (size_t i = 0; i < needed; i += 1) {
-            char ch = raw[offset + i];
-            img[i + 3] = reinterpret_cast<unsigned char&>(ch);
+        for (size_t i = 0; i < pixels; i += 1) {
+            img[i + 3] = bytes[i];
         }
     }
     return img;
 }
 
 // ascii/plain pgm, P2
-static std::vector<int> read_pgm2(const string& filename) {
-    vector<string> raw_lines = read_lines(filename);
-    vector<string> lines;
+static std::vector<int> read_pgm2(const MappedFile& file, const string& filename) {
+    vector<string_view> raw_lines;
+    split_lines(file.view(), raw_lines);
+    vector<string_view> lines;
     // no STL remove_if, as the compile time explodes
-    for (const string& line : raw_lines) {
-        if (!starts_with(line, "#")) { // ignore comments
-            // only nonempty line, empty lines ignored
-            if (line.find_first_of(CHARS_GERMAN_WORDS) != string::npos) {
-                lines.push_back(line);
-            }
+    for (const string_view& line : raw_lines) {
+        // comments already skipped by split_lines
+        // only nonempty line, empty lines ignored
+        if (line.find_first_of(CHARS_GERMAN_WORDS) != string::npos) {
+            lines.push_back(line);
         }
     }
     vector<string> words;
@@ -439,7 +772,6 @@ static std::vector<int> read_pgm2(const string& filename) {
     }
     // we have enough to identify the file
     if (words[0] != "P2") { // we use plain format
-        // for(auto word : words) { cout << word << " "; }; cout << endl;
         throw pbma_exception("keine PGM-Datei, kein P2-magic: ", filename);
     }
     int width, height, maxbright;
@@ -453,17 +785,16 @@ static std::vector<int> read_pgm2(const string& filename) {
         throw pbma_exception("keine PGM-Datei, keine maximale Helligkeit",
                              filename);
     }
-    // cout << "w=" << width << ", h=" << height;
-    // cout << ", mb=" << maxbright << endl;
+    const size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
     vector<int> img;
-    img.reserve(static_cast<size_t>(width * height + 3));
+    img.reserve(pixels + 3);
     img.push_back(width);
     img.push_back(height);
     img.push_back(maxbright);
     words.erase(words.begin(), words.begin() + 4);
     while (lit != lines.end()) {
         read_accept_str_vec(*lit, CHARS_INTEGRAL_WORDS, words);
-        for (auto word : words) {
+        for (const string& word : words) {
             int val;
             if (!str2int(word, val)) {
                 throw pbma_exception("Keine PGM-Datei, Pixel: ", word);
@@ -473,50 +804,51 @@ static std::vector<int> read_pgm2(const string& filename) {
         words.clear();
         ++lit;
     }
-    if (img.size() != static_cast<unsigned int>(width * height + 3)) {
+    if (img.size() != pixels + 3) {
         throw pbma_exception("Keine PGM-Datei, falsche Anzahl Pixel: ",
-                             static_cast<int>(img.size()));
+                             static_cast<long>(img.size()));
     }
     return img;
 }
 
-std::vector<int> read_pgm(const std::string& filename) {
-    ifstream is(filename, ifstream::binary);
-    if (!is) {
-        auto s = filename.c_str();
-        throw error(format("read_pgm: filename=%s nicht lesbar", s));
-    }
+static std::vector<int> read_pgm_named(const MappedFile& file, const string& filename) {
     // check magic number (P2 or P5)
-    vector<char> buffer(2); // identifier has two chars
-    is.read(buffer.data(), 2);
-    if (!is.good()) {
+    if (file.size() < 2) { // identifier has two chars
         auto s = filename.c_str();
         throw error(format("read_pgm: filename=%s Einlesefehler", s));
     }
-    is.close();
-    if (buffer[0] != 'P') {
+    const char* magic = file.data();
+    if (magic[0] != 'P') {
         auto s = filename.c_str();
         string msg = "filename=%s magic must start with 'P' not '%c'";
         msg = "read_pgm: " + msg;
-        throw error(format(msg, s, buffer[0]));
+        throw error(format(msg, s, magic[0]));
     }
     // based on magic number chose right reader
-    switch (buffer[1]) {
+    switch (magic[1]) {
     case '5':
-        return read_pgm5(filename);
+        return read_pgm5(file, filename);
         // no fall through as there is a return
     case '2':
-        return read_pgm2(filename);
+        return read_pgm2(file, filename);
         // no fall through as there is a return
     default: {
         auto s = filename.c_str();
         string msg = "filename=%s magic '2' or '5' not '%c'";
         msg = "read_pgm: " + msg;
-        throw error(format(msg, s, buffer[1]));
+        throw error(format(msg, s, magic[1]));
     }
     }
 }
 
+std::vector<int> read_pgm(const std::string& filename) {
+    return read_pgm_named(MappedFile(filename, MappedFile::Advice::sequential), filename);
+}
+
+std::vector<int> read_pgm(const MappedFile& file) {
+    return read_pgm_named(file, "(MappedFile)");
+}
+
 static bool is_pgm(const vector<int>& img) {
     const size_t imgsize = img.size();
     if (imgsize < 3) {
@@ -1087,31 +1419,66 @@ Timer::Timer() noexcept {
 }
 
 double Timer::measure() const noexcept {
-    const auto end = chrono::system_clock::now();
-    const chrono::duration<double> elapsed = end - start;
+    const chrono::duration<double> elapsed = clock::now() - start;
     return elapsed.count();
 }
 
 long Timer::measure_ms() const noexcept{
-    const auto end = chrono::system_clock::now();
-    const auto elapsed = chrono::duration_cast<chrono::milliseconds>(end - start);
+    const auto elapsed = chrono::duration_cast<chrono::milliseconds>(clock::now() - start);
     return static_cast<long>(elapsed.count());
 }
 
 long Timer::measure_us() const noexcept {
-    const auto end = chrono::system_clock::now();
-    const auto elapsed = chrono::duration_cast<chrono::microseconds>(end - start);
+    const auto elapsed = chrono::duration_cast<chrono::microseconds>(clock::now() - start);
     return static_cast<long>(elapsed.count());
 }
 
 long Timer::measure_ns() const noexcept {
-    const auto end = chrono::system_clock::now();
-    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(end - start);
+    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(clock::now() - start);
+    return static_cast<long>(elapsed.count());
+}
+
+long Timer::measure_net_ns() const noexcept {
+    return std::max(0L, measure_ns() - overhead_ns());
+}
+
+long Timer::lap_ns() noexcept {
+    const clock::time_point now = clock::now();
+    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(now - last_lap);
+    last_lap = now;
     return static_cast<long>(elapsed.count());
 }
 
 void Timer::restart() noexcept {
-    start = chrono::system_clock::now();
+    start = clock::now();
+    last_lap = start;
+}
+
+// Minimum über viele leere Messungen, einmal je Programmlauf
+long percentile_sorted(const std::vector<long>& sorted, double p) noexcept {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const double rank = std::ceil(p * static_cast<double>(sorted.size()));
+    const size_t r = rank < 1 ? 1 : min(static_cast<size_t>(rank), sorted.size());
+    return sorted[r - 1];
+}
+
+long percentile(std::vector<long> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    return percentile_sorted(samples, p);
+}
+
+long Timer::overhead_ns() noexcept {
+    static const long overhead = []() {
+        long best = LONG_MAX;
+        for (int i=0; i < 1000; ++i) {
+            Timer timer;
+            best = std::min(best, timer.measure_ns());
+        }
+        return best;
+    }();
+    return overhead;
 }
 
 // note, that all three are full and not truncated (modulo)
@@ -1140,9 +1507,11 @@ static string _human_format(long nanos, long mikros, long millis) {
 }
 
 string Timer::human_measure() const {
-    const long nanos = measure_ns();
-    const long mikros = measure_us(); // needed for systems with 32 bit long
-    const long millis = measure_ms(); // needed for systems with 32 bit long
+    // ein Uhrzugriff, alle drei Einheiten aus derselben Dauer
+    const auto elapsed = clock::now() - start;
+    const long nanos = static_cast<long>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count());
+    const long mikros = static_cast<long>(chrono::duration_cast<chrono::microseconds>(elapsed).count()); // needed for systems with 32 bit long
+    const long millis = static_cast<long>(chrono::duration_cast<chrono::milliseconds>(elapsed).count()); // needed for systems with 32 bit long
     return _human_format(nanos, mikros, millis);
 }
 
@@ -13,11 +13,13 @@
  * Verwendung: Beide Quell-Dateien pbma.(h|cpp) in das Projekt kopieren.
  */
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /** Ausnahme, wenn etwas schief geht, wird diese Ausnahme von
@@ -63,12 +65,107 @@ inline std::string format(int val, int length = 0, char fill_char = ' ') {
  */
 bool file_exists(const std::string& filename);
 
-/** Vollständiges Einlesen einer Datei als vector<char>
+/** Vollständiges Einlesen einer Datei als vector<char>, ohne Größengrenze;
+ * für große Dateien besser MappedFile, das den Speicher nicht verdoppelt
  * @param filename Dateiname der einzulesenden Datei
  * @return binärer Inhalt der Datei
  */
  std::vector<char> read_bytes(const std::string& filename);
 
+/** Nur-lesend in den Speicher eingeblendete Datei (mmap), ohne Kopie und
+ * ohne Größengrenze. Ohne mmap (kein POSIX) wird die Datei eingelesen,
+ * ebenso Pipes, /dev/stdin, /proc-Dateien und andere ohne bekannte Größe.
+ * Lebensdauer: data(), view() und alle daraus abgeleiteten Zeiger und
+ * string_views gelten, solange das Objekt lebt. Verschieben übergibt die
+ * Einblendung, die Zeiger bleiben gültig und gehören dann dem Ziel; das
+ * verschobene Objekt ist leer. Nicht kopierbar. Die Datei darf währenddessen
+ * nicht gekürzt werden (SIGBUS beim Zugriff), spätere Änderungen an ihr
+ * können sichtbar werden.
+ */
+class MappedFile {
+public:
+    /** Zugriffsmuster für madvise, nur Hinweise an das Betriebssystem */
+    enum class Advice {
+        normal,     //> keine Annahme
+        sequential, //> einmal von vorne nach hinten, aggressives Vorauslesen
+        random,     //> verstreute Zugriffe, kein Vorauslesen
+        willneed    //> bald benötigt, jetzt schon einlesen
+    };
+
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+    std::vector<char> _buffer; // ohne mmap oder keine reguläre Datei
+    bool _mapped = false;      // _data stammt von mmap
+    void unmap() noexcept;
+
+public:
+    /** Blendet die Datei ein, Ausnahme, falls nicht lesbar
+     * @param filename Dateiname der einzublendenden Datei
+     * @param advice erwartetes Zugriffsmuster, default normal
+     */
+    explicit MappedFile(const std::string& filename, Advice advice = Advice::normal);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /** Hinweis für einen Bereich, z.B. willneed für den nächsten Block;
+     * wird auf Seitengrenzen erweitert, Fehler werden ignoriert
+     * @param advice erwartetes Zugriffsmuster
+     * @param offset Beginn des Bereichs in Bytes
+     * @param length Länge des Bereichs, default bis zum Ende
+     */
+    void advise(Advice advice, size_t offset = 0, size_t length = SIZE_MAX) const noexcept;
+
+    const char* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    std::string_view view() const noexcept { return {_data, _size}; }
+};
+
+/** Zerlegt text an '\n' in Zeilen wie read_lines: leere Zeilen und
+ * Kommentarzeilen (#..) werden übersprungen, '\r' bleibt erhalten.
+ * Die Zeilen zeigen in text, es wird nichts kopiert.
+ * @param text zu zerlegender Text
+ * @param lines Ziel, die Zeilen werden angehängt
+ */
+void split_lines(std::string_view text, std::vector<std::string_view>& lines);
+
+/** Alle Zeilen einer Textdatei in einem einzigen Puffer: die Datei wird
+ * am Stück eingeblendet (MappedFile, ohne mmap gelesen) und mit memchr
+ * zerlegt, die Zeilen sind string_views in diesen Puffer, also ohne eine
+ * Allokation je Zeile. Gleiche Zeilen wie read_lines. Verschiebbar, nicht
+ * kopierbar; die Views gelten, solange das Objekt lebt.
+ */
+class LineBuffer {
+private:
+    MappedFile _file;
+    std::vector<std::string_view> _lines;
+
+public:
+    /** Liest und zerlegt die Datei, Ausnahme, falls nicht lesbar
+     * @param filename Dateiname der einzulesenden Datei
+     */
+    explicit LineBuffer(const std::string& filename);
+    /** Übernimmt eine bereits eingeblendete Datei
+     * @param file eingeblendete Datei, wird verschoben
+     */
+    explicit LineBuffer(MappedFile file);
+    LineBuffer(const LineBuffer&) = delete;
+    LineBuffer& operator=(const LineBuffer&) = delete;
+    LineBuffer(LineBuffer&&) noexcept = default;
+    LineBuffer& operator=(LineBuffer&&) noexcept = default;
+
+    const std::vector<std::string_view>& lines() const noexcept { return _lines; }
+    size_t size() const noexcept { return _lines.size(); }
+    bool empty() const noexcept { return _lines.empty(); }
+    std::string_view operator[](size_t i) const noexcept { return _lines[i]; }
+    std::vector<std::string_view>::const_iterator begin() const noexcept { return _lines.begin(); }
+    std::vector<std::string_view>::const_iterator end() const noexcept { return _lines.end(); }
+};
+
 /** Vollständiges Lesen einer Textdatei als vector<string>,
  * Kommentarzeilen (#..) ignorieren, leere Zeilen ignorieren,
  * Zeilen mit Whitespaces sind nicht leer
@@ -76,6 +173,8 @@ bool file_exists(const std::string& filename);
  * @return Zeilen der Datei
  */
 std::vector<std::string> read_lines(const std::string& filename);
+// dasselbe aus einer bereits eingeblendeten Datei, ohne Kopie
+std::vector<std::string> read_lines(const MappedFile& file);
 
 /** Wortweises Lesen einer Textdatei als vector<string>,
  * alphanumerische deutsche Worte, Satzzeichen etc. entfernen,
@@ -92,6 +191,8 @@ std::vector<std::string> read_words(const std::string& filename);
  * @return ints der Datei
  */
 std::vector<int> read_ints(const std::string& filename);
+// dasselbe aus einer bereits eingeblendeten Datei, ohne Kopie
+std::vector<int> read_ints(const MappedFile& file);
 
 /** Einlesen von Zahlen aus einer Textdatei als vector<long>,
  * numerische Wörter zu long konvertiert, Satzzeichen entfernen
@@ -100,6 +201,8 @@ std::vector<int> read_ints(const std::string& filename);
  * @return longs der Datei
  */
 std::vector<long> read_longs(const std::string& filename);
+// dasselbe aus einer bereits eingeblendeten Datei, ohne Kopie
+std::vector<long> read_longs(const MappedFile& file);
 
 /** Einlesen von Zahlen aus einer Textdatei als vector<double>,
  * numerische Wörter zu double konvertiert, Satzzeichen entfernen
@@ -108,6 +211,25 @@ std::vector<long> read_longs(const std::string& filename);
  * @return doubles der Datei
  */
 std::vector<double> read_doubles(const std::string& filename);
+// dasselbe aus einer bereits eingeblendeten Datei, ohne Kopie
+std::vector<double> read_doubles(const MappedFile& file);
+
+/** Wie read_ints, read_longs und read_doubles, aber parallel: die Datei
+ * wird in Stücke an Zeilengrenzen geteilt, jedes Stück von einem Thread
+ * gelesen und die Ergebnisse in der Reihenfolge der Datei zusammengefügt.
+ * Ergebnis und Ausnahmen sind dieselben wie bei den seriellen Funktionen.
+ * Dateien unter 1 MB je Thread werden mit weniger Threads gelesen.
+ * @param filename Dateiname der einzulesenden Datei
+ * @param jobs Anzahl der Threads, <= 0: alle Kerne
+ * @return Zahlen der Datei
+ */
+std::vector<int> read_ints_parallel(const std::string& filename, int jobs = 0);
+std::vector<long> read_longs_parallel(const std::string& filename, int jobs = 0);
+std::vector<double> read_doubles_parallel(const std::string& filename, int jobs = 0);
+// dasselbe aus bereits eingeblendeten Dateien, ohne Kopie
+std::vector<int> read_ints_parallel(const MappedFile& file, int jobs = 0);
+std::vector<long> read_longs_parallel(const MappedFile& file, int jobs = 0);
+std::vector<double> read_doubles_parallel(const MappedFile& file, int jobs = 0);
 
 /** Einlesen von Zahlen aus einer Textdatei als
  * zweidimensionalen Vektor vector<vector<int>>,
@@ -139,6 +261,11 @@ std::vector<std::vector<double>> read_2doubles(const std::string& filename);
  * @return img vector 3 Meta-Daten gefolgt von den Pixeln
  */
 std::vector<int> read_pgm(const std::string& filename);
+/** Wie read_pgm, aber aus einer bereits eingeblendeten Datei, ohne Kopie
+ * @param file eingeblendete PGM-Datei
+ * @return img vector 3 Meta-Daten gefolgt von den Pixeln
+ */
+std::vector<int> read_pgm(const MappedFile& file);
 
 /** Abspeichern eines Bilds im (ASCII) PGM-Format
  * Die ersten drei Zahlen sind Breite, Höhe, maximale Helligkeit.
@@ -461,11 +588,29 @@ int get_swaps() noexcept;
  */
 int reset_swaps() noexcept;
 
-/** Timer, um verbrauchte CPU-Zeit zu messen
+/** Perzentil nach Nearest-Rank: der Wert mit Rang ceil(p * n) in der
+ * aufsteigend sortierten Stichprobe, p50 ist also ein gemessener Wert
+ * @param sorted aufsteigend sortierte Stichprobe
+ * @param p zwischen 0 und 1, z.B. 0.5 für den Median
+ * @return Perzentil, 0 bei leerer Stichprobe
+ */
+long percentile_sorted(const std::vector<long>& sorted, double p) noexcept;
+
+/** wie percentile_sorted, sortiert dafür eine Kopie
+ * @param samples Stichprobe, beliebige Reihenfolge
+ * @param p zwischen 0 und 1
+ * @return Perzentil, 0 bei leerer Stichprobe
+ */
+long percentile(std::vector<long> samples, double p);
+
+/** Timer, um verbrauchte Zeit zu messen, monoton (steady_clock), springt
+ * also nicht bei Uhrzeitkorrekturen. Jede Messung liest die Uhr genau einmal.
  */
 class Timer {
 private:
-    std::chrono::system_clock::time_point start;
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start;
+    clock::time_point last_lap;
 
 public:
     Timer() noexcept;
@@ -473,11 +618,20 @@ public:
     long measure_ms() const noexcept; //> in Millisekunden
     long measure_us() const noexcept; //> in Mikrosekunden
     long measure_ns() const noexcept; //> in Nanosekunden
+    // wie measure_ns, aber abzüglich der kalibrierten Kosten eines Uhrzugriffs,
+    // für Phasen im Bereich weniger Mikrosekunden und darunter
+    long measure_net_ns() const noexcept;
+    // Zwischenzeit seit Start, ohne Neustart
+    long split_ns() const noexcept { return measure_ns(); }
+    // Rundenzeit seit dem letzten lap (bzw. Start), beginnt die nächste Runde
+    long lap_ns() noexcept;
     void restart() noexcept; // Neustart
     // messen und als für Menschen lesbarer String formatieren
     std::string human_measure() const;
     // für Menschen lesbarer String formatieren aus double Zeit in Sekunden
     static std::string human_format(double secs);
+    // Kosten von Start und Messung in ns, beim ersten Aufruf einmal bestimmt
+    static long overhead_ns() noexcept;
 };
 
 /** Schlafe ein paar Millisekunden